@@ -9,6 +9,7 @@
 */
 
 #include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+#include <Cstring.hpp>      // Cstring keys are compared by their characters, no matter if Cstring.hpp is included before or after Map.hpp
 
 
 void setup () {
@@ -75,6 +76,31 @@ void setup () {
 
     // Empty the map and release its memory
     Latin.clear (); // please note that AVR boards are not very good at releasing the memory
+
+    // Range queries: lower_bound and upper_bound find the bounds of the range in O (log n) time, so only the pairs in the range get visited
+    Map<unsigned long, float> readings ( { {1000, 21.5}, {2000, 21.7}, {3000, 22.0}, {4000, 22.4}, {5000, 22.1} } );
+    cout << "readings between 2000 and 4000 ms:\n";
+    auto last = readings.upper_bound (4000);
+    for (auto it = readings.lower_bound (2000); it != last; ++ it)
+        cout << it->first << " ms: " << it->second << " C\n";
+
+    // try_emplace and insert_or_assign search the tree only once and tell through the second member whether a new pair has been inserted
+    Map<String, int> counters;
+    counters.try_emplace ("rx", 0);
+    if (!counters.try_emplace ("rx", 100).second)
+        cout << "rx is already counting\n";
+    auto r = counters.insert_or_assign ("tx", 42);
+    if (r != err_ok)
+        cout << "insert_or_assign failed due to memory issue\n";
+    else
+        cout << r.first->first << " = " << r.first->second << (r.second ? " (new)" : "") << endl;
+
+    // Cstring keys can be found by C strings
+    Map<Cstring<10>, int> rooms;
+    rooms.insert ("kitchen", 1);
+    rooms.insert ("bedroom", 2);
+    if (rooms.find ("kitchen") != rooms.end ())
+        cout << "kitchen = " << rooms ["kitchen"] << ", there are " << rooms.size () << " rooms" << endl;
 }
 
 void loop () {
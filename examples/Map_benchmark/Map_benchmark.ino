@@ -0,0 +1,331 @@
+// #define MAP_MEMORY_TYPE PSRAM_MEM // uncomment this line if you want Map to use PSRAM instead of heap (ESP32 boards with PSRAM only)
+
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Map.hpp>          // balanced binary search tree with error handling and ability to use PSRAM for Arduino
+#include <unordered_map.hpp> // hash table with error handling and ability to use PSRAM for Arduino
+#include <btree_map.hpp>    // B-tree with error handling and ability to use PSRAM for Arduino
+
+
+#ifdef ARDUINO_ARCH_AVR
+    #define N 100           // AVR boards don't have much memory
+#elif MAP_MEMORY_TYPE == PSRAM_MEM
+    #define N 100000
+#else
+    #define N 2000          // fits into ESP32 heap
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+    #if MAP_MEMORY_TYPE == PSRAM_MEM
+        #define FREE_MEMORY() ESP.getFreePsram ()
+    #else
+        #define FREE_MEMORY() ESP.getFreeHeap ()
+    #endif
+#endif
+
+
+#define STRING_KEYS (N < 10000 ? N : 10000)
+
+
+// key comparison policies that count String comparisons: two-way is how Map used to compare keys (key < node key and then node key < key), three-way compares once with strcmp
+unsigned long comparisons;
+
+struct twoWayCompare {
+    template <class A, class B> static int compare (const A& a, const B& b) {
+        comparisons ++;
+        if (__mapLess__ (a, b))
+            return -1;
+        comparisons ++;
+        return __mapLess__ (b, a) ? 1 : 0;
+    }
+};
+
+struct threeWayCompare {
+    template <class A, class B> static int compare (const A& a, const B& b) {
+        comparisons ++;
+        return __mapCompare__ (a, b);
+    }
+};
+
+template <class mapType>
+void benchmarkStringKeys (const char *name) {
+    mapType S;
+    char key [20];
+    for (int i = 0; i < STRING_KEYS; i++) {
+        sprintf (key, "device_%05i", i);                            // common prefixes make each comparison more expensive
+        S.insert (key, i);
+    }
+    int found = 0;
+    comparisons = 0;
+    unsigned long t = micros ();
+        for (int i = 0; i < STRING_KEYS; i++) {
+            sprintf (key, "device_%05i", (int) ((i * 7919L) % STRING_KEYS));
+            found += S.contains (key);
+        }
+    t = micros () - t;
+    cout << name << t << " us, " << (float) comparisons / STRING_KEYS << " comparisons per lookup (found " << found << ")\n";
+    if (S.errorFlags () & err_bad_alloc)
+        cout << "out of memory, please decrease N\n";
+}
+
+
+// pseudo random keys, repeated calls with the same seed give the same sequence
+long nextKey (unsigned long& seed) {
+    seed = seed * 1103515245 + 12345;
+    return (long) (seed >> 1);
+}
+
+
+void setup () {
+
+    cinit ();                                                       // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    Map<long, int> M;
+    unsigned long seed;
+    unsigned long t;
+
+    cout << "----- Map<long, int> of " << N << " random keys -----\n";
+
+    seed = 1;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            M.insert (nextKey (seed), i);
+    t = micros () - t;
+    cout << "insert:            " << t << " us (height " << M.height () << ")\n";
+
+    seed = 1;
+    int found = 0;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            if (M.find (nextKey (seed)) != M.end ())
+                found ++;
+    t = micros () - t;
+    cout << "find:              " << t << " us (found " << found << ")\n";
+
+    seed = 1;
+    t = micros ();
+        for (int i = 0; i < N / 2; i++)
+            M.erase (nextKey (seed));
+    t = micros () - t;
+    cout << "erase half:        " << t << " us\n";
+
+    t = micros ();
+        M.clear ();
+    t = micros () - t;
+    cout << "clear the rest:    " << t << " us\n";
+
+    cout << "----- Map<long, int> of " << N << " sequential keys -----\n";
+
+    t = micros ();
+        for (long i = 0; i < N; i++)
+            M.insert (i, 0);
+    t = micros () - t;
+    cout << "insert:            " << t << " us (height " << M.height () << ")\n";
+
+    t = micros ();
+        for (long i = 0; i < N; i++)
+            M.erase (i);
+    t = micros () - t;
+    cout << "erase:             " << t << " us\n";
+
+    cout << "----- loading a sorted table of " << N << " pairs at startup -----\n";
+
+    Map<long, int>::Pair *table = (Map<long, int>::Pair *) malloc (N * sizeof (Map<long, int>::Pair));
+    if (table) {
+        for (int i = 0; i < N; i++)
+            table [i] = { 10L * i, i };
+
+        t = micros ();
+            for (int i = 0; i < N; i++)
+                M.insert (table [i].first, table [i].second);
+        t = micros () - t;
+        cout << "insert one by one: " << t << " us (height " << M.height () << ")\n";
+
+        M.clear ();
+        t = micros ();
+            M.assign_sorted (table, table + N);                     // builds balanced binary search tree directly, all the nodes are allocated at once
+        t = micros () - t;
+        cout << "assign_sorted:     " << t << " us (height " << M.height () << ")\n";
+
+        M.clear ();
+        free (table);
+    }
+
+    cout << "----- allocation rate of " << N << " nodes -----\n";
+
+    #define NODE_SIZE (sizeof (long) + sizeof (int) + 2 * sizeof (void *) + 2)   // approximately the size of Map<long, int> node
+    #define BLOCKS (N < 1000 ? N : 1000)                                        // allocate and free in batches
+    static void *block [BLOCKS];
+
+    t = micros ();
+        for (int j = 0; j < N / BLOCKS; j++) {
+            for (int i = 0; i < BLOCKS; i++)
+                block [i] = malloc (NODE_SIZE);
+            for (int i = 0; i < BLOCKS; i++)
+                free (block [i]);
+        }
+    t = micros () - t;
+    cout << "malloc + free:     " << t << " us\n";
+
+    __mapNodePool__<NODE_SIZE> pool;
+    t = micros ();
+        for (int j = 0; j < N / BLOCKS; j++) {
+            for (int i = 0; i < BLOCKS; i++)
+                block [i] = pool.allocate ();
+            for (int i = 0; i < BLOCKS; i++)
+                if (block [i])
+                    pool.deallocate (block [i]);
+        }
+    t = micros () - t;
+    cout << "node pool:         " << t << " us\n";
+
+    cout << "----- insert / erase churn, session table of " << N / 10 << " keys -----\n";
+
+    seed = 2;
+    for (int i = 0; i < N / 10; i++)
+        M.insert (nextKey (seed), i);
+    unsigned long oldestSeed = 2;
+    t = micros ();
+        for (int i = 0; i < N; i++) {
+            M.erase (nextKey (oldestSeed)); // the oldest session expires
+            M.insert (nextKey (seed), i);   // and a new one starts
+        }
+    t = micros () - t;
+    cout << "erase + insert:    " << t << " us, " << (float) N / t * 1000000 << " pairs per second\n";
+    M.clear ();
+
+    cout << "----- in-order iteration over Map<String, int> of " << N << " keys -----\n";
+
+    Map<String, int> S;
+    for (int i = 0; i < N; i++)
+        S.insert (String ("session_") + String (i), i);
+    long sum = 0;
+    t = micros ();
+        for (auto& p: S)
+            sum += p.second;
+    t = micros () - t;
+    cout << "iterate:           " << t << " us (checksum " << sum << ")\n";
+
+    cout << "----- looking up String keys from C strings -----\n";
+
+    char key [20];
+    found = 0;
+    t = micros ();
+        for (int i = 0; i < N; i++) {
+            sprintf (key, "session_%i", i);
+            found += S.find (String (key)) != S.end ();             // one temporary String (heap allocation) per lookup
+        }
+    t = micros () - t;
+    cout << "find (String (key)): " << t << " us (found " << found << ", " << N << " temporary Strings)\n";
+
+    found = 0;
+    t = micros ();
+        for (int i = 0; i < N; i++) {
+            sprintf (key, "session_%i", i);
+            found += S.contains (key);                              // C string is compared directly with String keys, no allocation
+        }
+    t = micros () - t;
+    cout << "contains (key):      " << t << " us (found " << found << ", no temporary Strings)\n";
+
+    S.clear ();
+
+    cout << "----- two-way vs three-way comparison, " << STRING_KEYS << " String keys -----\n";
+
+    benchmarkStringKeys<Map<String, int, twoWayCompare>> ("two-way (<, <):     ");
+    benchmarkStringKeys<Map<String, int, threeWayCompare>> ("three-way (strcmp): ");
+
+    for (long n = 1000; n <= N; n *= 10) {
+        cout << "----- Map vs unordered_map with " << n << " String keys -----\n";
+
+        Map<String, int> Ms;
+        t = micros ();
+            for (int i = 0; i < n; i++)
+                Ms.insert (String ("device_") + String (i), i);
+        t = micros () - t;
+        cout << "Map insert:           " << t << " us\n";
+        found = 0;
+        t = micros ();
+            for (int i = 0; i < n; i++)
+                found += Ms.find (String ("device_") + String (i)) != Ms.end ();
+        t = micros () - t;
+        cout << "Map find:             " << t << " us (found " << found << ")\n";
+        if (Ms.errorFlags () & err_bad_alloc)
+            cout << "out of memory, please decrease N\n";
+        Ms.clear ();
+
+        unordered_map<String, int> Us;
+        t = micros ();
+            for (int i = 0; i < n; i++)
+                Us.insert (String ("device_") + String (i), i);
+        t = micros () - t;
+        cout << "unordered_map insert: " << t << " us\n";
+        found = 0;
+        t = micros ();
+            for (int i = 0; i < n; i++)
+                found += Us.find (String ("device_") + String (i)) != Us.end ();
+        t = micros () - t;
+        cout << "unordered_map find:   " << t << " us (found " << found << ")\n";
+        if (Us.errorFlags () & err_bad_alloc)
+            cout << "out of memory, please decrease N\n";
+    }
+
+    cout << "----- Map vs btree_map<long, int> of " << N << " random keys -----\n";
+
+    btree_map<long, int> B;
+    #ifdef ARDUINO_ARCH_ESP32
+        size_t memory = FREE_MEMORY ();
+    #endif
+    seed = 3;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            M.insert (nextKey (seed), i);
+    t = micros () - t;
+    cout << "Map insert:          " << t << " us (height " << M.height () << ")\n";
+    #ifdef ARDUINO_ARCH_ESP32
+        cout << "Map memory:          " << (float) (memory - FREE_MEMORY ()) / M.size () << " bytes per pair\n";
+        memory = FREE_MEMORY ();
+    #endif
+    seed = 3;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            B.insert (nextKey (seed), i);
+    t = micros () - t;
+    cout << "btree_map insert:    " << t << " us (height " << B.height () << ")\n";
+    #ifdef ARDUINO_ARCH_ESP32
+        cout << "btree_map memory:    " << (float) (memory - FREE_MEMORY ()) / B.size () << " bytes per pair\n";
+    #endif
+
+    seed = 3;
+    found = 0;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            found += M.contains (nextKey (seed));
+    t = micros () - t;
+    cout << "Map find:            " << t << " us (found " << found << ")\n";
+    seed = 3;
+    found = 0;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            found += B.contains (nextKey (seed));
+    t = micros () - t;
+    cout << "btree_map find:      " << t << " us (found " << found << ")\n";
+
+    seed = 3;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            M.erase (nextKey (seed));
+    t = micros () - t;
+    cout << "Map erase:           " << t << " us\n";
+    seed = 3;
+    t = micros ();
+        for (int i = 0; i < N; i++)
+            B.erase (nextKey (seed));
+    t = micros () - t;
+    cout << "btree_map erase:     " << t << " us\n";
+
+    if ((M.errorFlags () | S.errorFlags () | B.errorFlags ()) & err_bad_alloc)
+        cout << "out of memory, please decrease N\n";
+}
+
+void loop () {
+
+}
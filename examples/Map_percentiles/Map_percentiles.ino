@@ -0,0 +1,46 @@
+#define MAP_ORDER_STATISTICS // Map nodes keep the sizes of their subtrees, this enables rank, select and nth functions
+
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+
+
+#define WINDOW 200          // rolling percentiles over the last 200 samples
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // the keys are latencies [us] * 1000 + sample number % 1000 so that the keys of equal latencies are still unique, the values are the sample numbers
+    Map<long, int> latencies;
+    static long window [WINDOW];                              // the keys in the window, so the oldest one can be erased
+    unsigned long seed = 1;
+
+    for (int sample = 0; sample < 1000; sample++) {
+        // measure (simulate) the latency
+        seed = seed * 1103515245 + 12345;
+        long latency = 1000 + (seed >> 16) % 4000 + ((seed >> 8) % 20 == 0 ? 10000 : 0); // 1 - 5 ms and occasional spikes
+
+        // slide the window
+        if (sample >= WINDOW)
+            latencies.erase (window [sample % WINDOW]);
+        window [sample % WINDOW] = latency * 1000 + sample % 1000;
+        latencies.insert (window [sample % WINDOW], sample);
+
+        if (sample % 100 == 99) {
+            // percentiles in O (log n) time instead of iterating from begin ()
+            int n = latencies.size ();
+            cout << "sample " << sample + 1 << ": median " << latencies.nth (n / 2)->first / 1000 << " us"
+                 << ", p90 " << latencies.nth (n * 9 / 10)->first / 1000 << " us"
+                 << ", p99 " << latencies.nth (n * 99 / 100)->first / 1000 << " us"
+                 << ", below 2 ms: " << latencies.rank (2000L * 1000) * 100 / n << " %\n";
+        }
+    }
+
+    if (latencies.errorFlags ())
+        cout << "map error, flags: " << latencies.errorFlags () << endl;
+}
+
+void loop () {
+
+}
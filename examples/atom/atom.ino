@@ -0,0 +1,90 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+
+#include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+#include <atom.hpp>         // interned strings that compare in O (1) for Arduino
+
+
+void onTemperature (const char *payload) { cout << "temperature: " << payload << endl; }
+void onHumidity (const char *payload) { cout << "humidity: " << payload << endl; }
+void onLight (const char *payload) { cout << "light: " << payload << endl; }
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // Each topic string is stored only once, the handlers are looked up by comparing pointers instead of characters
+    Map<atom, void (*) (const char *)> handlers;
+    handlers [atom ("home/livingroom/temperature")] = onTemperature;
+    handlers [atom ("home/livingroom/humidity")] = onHumidity;
+    handlers [atom ("home/livingroom/light")] = onLight;
+
+    // Topics of received messages are only looked up, unknown topics are not stored
+    const char *received [] = { "home/livingroom/humidity", "home/kitchen/smoke", "home/livingroom/temperature" };
+    for (const char *topic : received) {
+        auto h = handlers.find (atom::find (topic));
+        if (h != handlers.end ())
+            h->second ("42");
+        else
+            cout << "no handler for " << topic << endl;
+    }
+
+    // Atoms of equal strings are equal, no matter where the strings came from
+    String topic = "home/livingroom/light";
+    if (atom (topic) == atom ("home/livingroom/light"))
+        cout << atom (topic) << " is stored only once\n";
+
+    atom_table& table = atom_table::shared ();
+    cout << table.size () << " topics take " << table.bytes () << " bytes\n";
+    if (table.errorFlags ())
+        cout << "some topics couldn't be stored due to memory issue\n";
+
+
+    // Compare the lookups with String keys
+    #define TOPICS 100
+    Map<String, int> byString;
+    Map<atom, int> byAtom;
+    atom topics [TOPICS];
+    for (int i = 0; i < TOPICS; i++) {
+        char s [40];
+        sprintf (s, "home/sensors/device_%03i/state", i);
+        byString [s] = i;
+        topics [i] = atom (s);
+        byAtom [topics [i]] = i;
+    }
+
+    unsigned long start = micros ();
+    long sum = 0;
+    for (int j = 0; j < 10; j++)
+        for (int i = 0; i < TOPICS; i++) {
+            char s [40];
+            sprintf (s, "home/sensors/device_%03i/state", i);
+            sum += byString.find (s)->second;
+        }
+    cout << "String keys: " << (micros () - start) << " us for " << 10 * TOPICS << " lookups\n";
+
+    start = micros ();
+    for (int j = 0; j < 10; j++)
+        for (int i = 0; i < TOPICS; i++) {
+            char s [40];
+            sprintf (s, "home/sensors/device_%03i/state", i);
+            sum += byAtom.find (atom::find (s))->second;
+        }
+    cout << "atom keys (hashing the received topic): " << (micros () - start) << " us for " << 10 * TOPICS << " lookups\n";
+
+    start = micros ();
+    for (int j = 0; j < 10; j++)
+        for (int i = 0; i < TOPICS; i++)
+            sum += byAtom.find (topics [i])->second;
+    cout << "atom keys (already known): " << (micros () - start) << " us for " << 10 * TOPICS << " lookups\n";
+    cout << "checksum: " << sum << endl;
+}
+
+void loop () {
+
+}
@@ -0,0 +1,58 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord, wide B-tree nodes need fewer slow PSRAM reads than binary search tree nodes
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+/* make the nodes larger or smaller, the default is 256 bytes (64 bytes on AVR boards)
+    #define BTREE_MAP_NODE_SIZE 512
+*/
+
+#include <btree_map.hpp>    // B-tree with error handling and ability to use PSRAM for Arduino
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // Log temperature readings by the time they were taken, many small pairs are stored compactly, since B-tree nodes hold them in sorted arrays
+    btree_map<unsigned long, float> readings;
+    for (unsigned long t = 0; t < 1000; t += 10)
+        readings.insert (t, 20.0 + (t % 70) / 10.0);
+
+    // Check success of each individual operation
+    switch (readings.insert (500, 25.0)) {
+        case err_bad_alloc: 
+                            cout << "insert failed due to memory issue\n";
+                            break;
+        case err_not_unique:
+                            cout << "the key already exists\n";
+                            break;
+    }
+    readings.clearErrorFlags ();
+
+    // or use []
+    readings [1000] = 21.5;
+
+    cout << "There are " << readings.size () << " readings in the B-tree of height " << readings.height () << endl;
+
+    // Print the readings between 200 and 300, the pairs are sorted by their keys
+    auto last = readings.upper_bound (300);
+    for (auto it = readings.lower_bound (200); it != last; ++ it)
+        cout << it->first << ": " << it->second << endl;
+
+    // Erase the old readings
+    for (unsigned long t = 0; t < 500; t += 10)
+        readings.erase (t);
+
+    // Find a reading
+    float *r = readings.get_if (600);
+    if (r)
+        cout << "reading at 600: " << *r << endl;
+
+    cout << "first reading: " << readings.begin ()->first << ", last reading: " << (-- readings.end ())->first << endl;
+}
+
+void loop () {
+
+}
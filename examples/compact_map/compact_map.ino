@@ -0,0 +1,63 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+
+#include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+#include <compact_map.hpp>  // maps with compact nodes for many small pairs for Arduino
+
+
+// prints the bytes per pair of Map and compact_map (with 16-bit and 32-bit indexes) for the given key and value types
+template <class keyType, class valueType>
+void report (const char *types) {
+    cout << types << ":  Map " << Map<keyType, valueType>::node_size ()
+         << ",  compact_map " << compact_map<keyType, valueType>::node_size ()
+         << " (32-bit indexes " << compact_map<keyType, valueType, uint32_t>::node_size () << ")\n";
+}
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // compact_map is used the same way as Map
+    compact_map<uint16_t, uint16_t> registers;
+    registers [0x10] = 500;
+    registers [0x20] = 1000;
+    if (registers.insert (0x30, 1500) != err_ok)
+        cout << "insert failed due to memory issue\n";
+    registers.erase (0x20);
+    for (auto& r : registers)
+        cout << "register " << r.first << " = " << r.second << endl;
+
+    auto it = registers.find (0x30);
+    if (it != registers.end ())
+        cout << "found " << it->second << endl;
+
+
+    // Bytes per pair: a Map node holds the pair, three pointers and two heights, a compact_map node holds the pair and two indexes with the balance packed in them
+    cout << "\nbytes per pair\n";
+    report<uint8_t, uint8_t> ("uint8_t, uint8_t  ");
+    report<uint16_t, uint16_t> ("uint16_t, uint16_t");
+    report<int, int> ("int, int          ");
+    report<uint32_t, float> ("uint32_t, float   ");
+    report<int, double> ("int, double       ");
+    report<String, int> ("String, int       ");
+
+
+    // The node array doubles when it gets full, so there may be up to half of the array unused
+    #define PAIRS 1000
+    compact_map<uint16_t, uint16_t> cm;
+    for (int i = 0; i < PAIRS; i++)
+        cm [i] = i;
+    if (cm.errorFlags ())
+        cout << "some pairs couldn't be inserted due to memory issue\n";
+    cout << "\n" << cm.size () << " pairs of compact_map<uint16_t, uint16_t> take " << cm.bytes () << " bytes, " << (float) cm.bytes () / cm.size () << " bytes per pair\n";
+    cout << cm.size () << " pairs of Map<uint16_t, uint16_t> take about " << PAIRS * Map<uint16_t, uint16_t>::node_size () << " bytes\n";
+}
+
+void loop () {
+
+}
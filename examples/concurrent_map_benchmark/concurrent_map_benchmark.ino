@@ -0,0 +1,97 @@
+// #define MAP_MEMORY_TYPE PSRAM_MEM // uncomment this line if you want concurrent_map and Map to use PSRAM instead of heap (ESP32 boards with PSRAM only)
+
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Map.hpp>          // balanced binary search tree with error handling and ability to use PSRAM for Arduino
+#include <concurrent_map.hpp> // sharded maps with reader-writer locks for Arduino
+
+#include <thread>           // std::thread runs as a FreeRTOS task on ESP32 boards, this benchmark doesn't run on AVR boards
+#include <mutex>
+
+
+#define KEYS 1000
+#define OPERATIONS 100000   // per thread
+#define WRITES 10           // percent of the operations that change values, the rest only read them
+
+
+// one Map shared by all the threads through one global mutex - the way it had to be done before
+Map<int, int> globalMap;
+std::mutex globalMutex;
+
+// concurrent_map with 16 shards
+concurrent_map<int, int, 16> shardedMap;
+
+
+void globalMapWork (unsigned long seed, long *checksum) {
+    long sum = 0;
+    for (long i = 0; i < OPERATIONS; i++) {
+        seed = seed * 1103515245 + 12345;
+        int key = (seed >> 8) % KEYS;
+        std::lock_guard<std::mutex> guard (globalMutex);
+        if ((seed >> 24) % 100 < WRITES) {
+            globalMap.insert_or_assign (key, (int) i);
+        } else {
+            auto it = globalMap.find (key);
+            if (it != globalMap.end ())
+                sum += it->second;
+        }
+    }
+    *checksum = sum;
+}
+
+struct adder {
+    long *sum;
+    void operator () (const int& value) { *sum += value; }
+};
+
+void shardedMapWork (unsigned long seed, long *checksum) {
+    long sum = 0;
+    for (long i = 0; i < OPERATIONS; i++) {
+        seed = seed * 1103515245 + 12345;
+        int key = (seed >> 8) % KEYS;
+        if ((seed >> 24) % 100 < WRITES)
+            shardedMap.insert_or_assign (key, (int) i);
+        else
+            shardedMap.find_and_apply (key, adder { &sum });
+    }
+    *checksum = sum;
+}
+
+// runs the work in the given number of threads and returns the number of operations per millisecond
+long run (void (*work) (unsigned long, long *), int threads) {
+    std::thread *t [8];
+    long checksums [8];
+    unsigned long start = micros ();
+    for (int i = 0; i < threads; i++)
+        t [i] = new std::thread (work, 1 + i, &checksums [i]);
+    for (int i = 0; i < threads; i++) {
+        t [i]->join ();
+        delete t [i];
+    }
+    unsigned long us = micros () - start;
+    return us ? (long) ((long long) threads * OPERATIONS * 1000 / us) : 0;
+}
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    for (int i = 0; i < KEYS; i++) {
+        globalMap.insert (i, i);
+        shardedMap.insert (i, i);
+    }
+    if (globalMap.errorFlags () || shardedMap.errorFlags ())
+        cout << "insert failed due to memory issue\n";
+
+    cout << "operations per ms with " << WRITES << "% writes:\n";
+    cout << "threads    Map + global mutex    concurrent_map\n";
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        long g = run (globalMapWork, threads);
+        long s = run (shardedMapWork, threads);
+        cout << "   " << threads << "            " << g << "               " << s << endl;
+    }
+}
+
+void loop () {
+
+}
@@ -0,0 +1,65 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define LIST_MEMORY_TYPE          PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+/* define THROW_LIST_EXCEPTIONS if you want lists to throw exceptions in case of errors rather then reporting them through errorFlags () function
+    #define THROW_LIST_EXCEPTIONS 
+*/
+
+#include <dlist.hpp>        // double linked lists with error handling and ability to use PSRAM for Arduino
+#include <algorithm.hpp>    // find, heap sort for vectors, ... merge sort for lists
+
+
+void setup () {
+
+    cinit ();                                                       // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // Use double linked list as a small LRU buffer of recently used pages
+    dlist<int> recentlyUsed ( { 1, 2, 3, 4 } );
+
+    // Page 3 has been used again - move it to the front without any copying or memory allocation
+    auto it = find (recentlyUsed.begin (), recentlyUsed.end (), 3);
+    if (it != recentlyUsed.end ())
+        recentlyUsed.splice (recentlyUsed.begin (), recentlyUsed, it);
+
+    // Page 5 is new - add it to the front and drop the least recently used one from the back
+    recentlyUsed.push_front (5);
+    recentlyUsed.pop_back ();
+
+    // Check if the list is in error state (after many operations) ...
+    signed char e = recentlyUsed.errorFlags ();
+    if (e) {                                          
+        cout << "list error, flags: " << e << endl; 
+        if (e & err_bad_alloc)    
+            cout << "err_bad_alloc\n";
+        if (e & err_out_of_range) 
+            cout << "err_out_of_range\n";
+
+        recentlyUsed.clearErrorFlags ();   
+    }
+
+    cout << "Most recently used first: " << recentlyUsed << endl;
+
+    // Iterate backwards
+    cout << "Least recently used first: ";
+    for (auto r = recentlyUsed.rbegin (); r != recentlyUsed.rend (); ++ r)
+        cout << *r << "   ";
+    cout << endl;
+
+    // Erase through iterator doesn't have to search for the previous element
+    for (auto i = recentlyUsed.begin (); i != recentlyUsed.end (); )
+        if (*i % 2 == 0)
+            i = recentlyUsed.erase (i);
+        else
+            ++ i;
+    cout << "Odd pages only: " << recentlyUsed << endl;
+
+    // Empty the list and release its memory
+    recentlyUsed.clear (); // please note that AVR boards are not very good at releasing the memory
+}
+
+void loop () {
+
+}
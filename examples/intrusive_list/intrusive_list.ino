@@ -0,0 +1,62 @@
+#include <ostream.hpp>      // cout instance for Arduino
+#include <intrusive_list.hpp> // lists that link objects through their own hooks, without allocating any memory
+#include <algorithm.hpp>    // find, heap sort for vectors, ... merge sort for lists
+
+
+// objects that can be linked into intrusive lists embed their own hooks
+struct job_t {
+    int id;
+    int priority;
+    intrusive_list_hook hook;                                       // links for the list of pending jobs
+
+    bool operator < (const job_t& other) const { return priority < other.priority; } // needed for sort
+    bool operator == (const int& otherId) const { return id == otherId; }              // needed for find by id
+};
+
+job_t jobs [5] = { {1, 30, {}}, {2, 10, {}}, {3, 50, {}}, {4, 20, {}}, {5, 40, {}} };  // static storage, no heap is used
+intrusive_list<job_t, &job_t::hook> pending;
+
+volatile bool job4Cancelled = false;
+
+// linking and unlinking doesn't allocate memory, so it can be done in ISR as well (the loop must disable interrupts while using the same list)
+void cancelJob4 () {
+    pending.remove (jobs [3]);
+    job4Cancelled = true;
+}
+
+
+void setup () {
+
+    cinit ();                                                       // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    for (auto& j: jobs)
+        pending.push_back (j);
+
+    // Linking the same object twice is reported as an error
+    if (pending.push_back (jobs [0]) == err_not_unique)
+        cout << "job 1 is already pending\n";
+
+    // Sorting only relinks the objects
+    sort (pending.begin (), pending.end ());
+    cout << "Pending jobs by priority: ";
+    for (auto& j: pending)
+        cout << j.id << "   ";
+    cout << endl;
+
+    auto f = find (pending.begin (), pending.end (), 3);
+    if (f != pending.end ())
+        cout << "Job 3 has priority " << f->priority << endl;
+
+    // Unlinking is O(1), no searching is needed
+    cancelJob4 ();
+    cout << "There are " << pending.size () << " pending jobs left" << endl;
+
+    while (!pending.empty ()) {
+        cout << "Running job " << pending.front ().id << endl;
+        pending.pop_front ();
+    }
+}
+
+void loop () {
+
+}
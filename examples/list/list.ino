@@ -60,6 +60,15 @@ void setup () {
     if (m != Fibonacci.end ())                                     // if not empty
         cout << "Max element in the list = " << *m << endl;
 
+    // Delete elements while iterating, erase_after doesn't need to search for the previous element
+    for (auto prev = Fibonacci.before_begin (), it = Fibonacci.begin (); it != Fibonacci.end (); )
+        if (*it == 1)
+            it = Fibonacci.erase_after (prev);
+        else
+            prev = it, ++ it;
+    Fibonacci.insert_after (Fibonacci.before_begin (), 1);          // the same as push_front
+    cout << "After removing and inserting ones: " << Fibonacci << endl;
+
     cout << "Merge-sorted: ";
     sort (Fibonacci.begin (), Fibonacci.end ());
     cout << Fibonacci << endl;
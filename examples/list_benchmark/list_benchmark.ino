@@ -0,0 +1,120 @@
+#include <ostream.hpp>      // cout instance for Arduino
+#include <list.hpp>         // single linked lists with error handling and ability to use PSRAM for Arduino
+#include <unrolled_list.hpp> // lists with more elements per node
+#include <algorithm.hpp>    // find, heap sort for vectors, ... merge sort for lists
+
+
+#ifdef ARDUINO_ARCH_AVR
+    #define N 200           // AVR boards don't have much memory
+#else
+    #define N 10000
+#endif
+
+
+// fill the list with pseudo random numbers
+void fill (list<int>& l, int n, unsigned long seed) {
+    l.clear ();
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        l.push_back ((int) (seed >> 16) & 0x7fff);
+    }
+}
+
+
+void setup () {
+
+    cinit ();                                                       // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    list<int> A;
+    list<int> B;
+    unsigned long t;
+
+    cout << "----- concatenating two lists of " << N << " elements -----\n";
+
+    fill (A, N, 1); fill (B, N, 2);
+    t = micros ();
+        for (auto e: B)                                             // copy - based concatenation: one malloc and one copy per element
+            A.push_back (e);
+        B.clear ();
+    t = micros () - t;
+    cout << "push_back copy:    " << t << " us\n";
+
+    fill (A, N, 1); fill (B, N, 2);
+    t = micros ();
+        A.splice (A.end (), B);                                     // only relinks pointers
+    t = micros () - t;
+    cout << "splice:            " << t << " us\n";
+
+    cout << "----- sorting a list of " << N << " elements -----\n";
+
+    fill (A, N, 3);
+    t = micros ();
+        sort (A.begin (), A.end ());
+    t = micros () - t;
+    cout << "sort (algorithm):  " << t << " us\n";
+
+    fill (A, N, 3);
+    t = micros ();
+        A.sort ();
+    t = micros () - t;
+    cout << "A.sort ():         " << t << " us\n";
+
+    cout << "----- merging two sorted lists of " << N << " elements -----\n";
+
+    fill (A, N, 4); A.sort ();
+    fill (B, N, 5); B.sort ();
+    t = micros ();
+        A.merge (B);
+    t = micros () - t;
+    cout << "A.merge (B):       " << t << " us\n";
+
+    cout << "----- list<int> vs unrolled_list<int, 16> of " << N << " elements -----\n";
+
+    // memory per element: list node holds one element and one pointer, unrolled list node holds 16 elements, two pointers and a counter (plus malloc header for each node)
+    struct listNode { int element; void *next; };
+    struct unrolledNode { void *next; void *prev; unsigned char count; int element [16]; };
+    #ifdef ARDUINO_ARCH_ESP32
+        #define MALLOC_HEADER 8 // approximately
+    #else
+        #define MALLOC_HEADER 4 // approximately
+    #endif
+    cout << "bytes per element: list " << (float) (sizeof (listNode) + MALLOC_HEADER) << ", unrolled_list " << (float) (sizeof (unrolledNode) + MALLOC_HEADER) / 16 << " (when nodes are full)\n";
+
+    #ifdef ARDUINO_ARCH_ESP32
+        A.clear (); // A still holds the merged elements
+        size_t heap = ESP.getFreeHeap ();
+        fill (A, N, 6);
+        cout << "measured heap:     list " << (float) (heap - ESP.getFreeHeap ()) / N << " bytes per element, ";
+        A.clear ();
+    #endif
+    unrolled_list<int, 16> U;
+    #ifdef ARDUINO_ARCH_ESP32
+        heap = ESP.getFreeHeap ();
+    #endif
+    for (int i = 0; i < N; i++)
+        U.push_back (i);
+    #ifdef ARDUINO_ARCH_ESP32
+        cout << "unrolled_list " << (float) (heap - ESP.getFreeHeap ()) / N << " bytes per element\n";
+    #endif
+
+    fill (A, N, 6);
+    long sum = 0;
+    t = micros ();
+        for (auto e: A)
+            sum += e;
+    t = micros () - t;
+    cout << "traverse list:     " << t << " us\n";
+
+    t = micros ();
+        for (auto e: U)
+            sum += e;
+    t = micros () - t;
+    cout << "traverse unrolled: " << t << " us     (checksum " << sum << ")\n";
+
+    if (A.errorFlags () || B.errorFlags () || U.errorFlags ())
+        cout << "out of memory, please decrease N\n";
+}
+
+void loop () {
+
+}
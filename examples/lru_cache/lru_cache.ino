@@ -0,0 +1,49 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+
+#include <lru_cache.hpp>    // least recently used cache with error handling and ability to use PSRAM for Arduino
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // Cache at most 4 DNS results, when a new one comes the least recently used one gets evicted
+    lru_cache<String, String> dns (4);
+
+    dns.put ("example.com", "93.184.215.14");
+    dns.put ("arduino.cc", "100.24.172.113");
+    dns.put ("github.com", "140.82.121.4");
+    dns.put ("espressif.com", "47.254.50.199");
+
+    // Looking up a name makes it the most recently used one
+    String *ip = dns.get ("example.com");
+    if (ip)
+        cout << "example.com: " << *ip << endl;
+
+    // The cache is full, arduino.cc is the least recently used one now, so it is evicted
+    if (dns.put ("pool.ntp.org", "162.159.200.1") != err_ok)
+        cout << "put failed due to memory issue\n";
+
+    if (!dns.get ("arduino.cc"))
+        cout << "arduino.cc is not cached anymore\n";
+
+    // Pairs from the most recently used one to the least recently used one
+    for (auto& pair: dns)
+        cout << pair.first << " - " << pair.second << endl;
+
+    cout << "hits: " << dns.hits () << ", misses: " << dns.misses () << ", evictions: " << dns.evictions () << endl;
+
+    // Cache rendered pages within 2 KB, the large pages evict more of the older ones
+    lru_cache<String, String> pages (16, 2048);
+    pages.put ("/index.html", "<html>...</html>");
+    cout << pages.size () << " pages take " << pages.bytes () << " bytes\n";
+}
+
+void loop () {
+
+}
@@ -0,0 +1,116 @@
+// #define MAP_MEMORY_TYPE PSRAM_MEM // uncomment this line if you want lru_cache and Map to use PSRAM instead of heap (ESP32 boards with PSRAM only)
+
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Map.hpp>          // balanced binary search tree with error handling and ability to use PSRAM for Arduino
+#include <lru_cache.hpp>    // least recently used cache with error handling and ability to use PSRAM for Arduino
+
+
+#ifdef ARDUINO_ARCH_AVR
+    #define KEYS 50         // AVR boards don't have much memory
+    #define ACCESSES 2000
+#else
+    #define KEYS 10000
+    #define ACCESSES 100000
+#endif
+#define CAPACITY (KEYS / 10)
+
+
+// Zipfian access trace: the k-th most popular key is accessed with probability proportional to 1 / k, so a few keys get most of the accesses
+float *cdf;
+
+void initZipf () {
+    cdf = (float *) malloc (KEYS * sizeof (float));
+    if (!cdf)
+        return;
+    float sum = 0;
+    for (int k = 0; k < KEYS; k++)
+        cdf [k] = sum += 1.0 / (k + 1);
+    for (int k = 0; k < KEYS; k++)
+        cdf [k] /= sum;
+}
+
+long nextZipfKey (unsigned long& seed) {
+    seed = seed * 1103515245 + 12345;
+    float u = (float) ((seed >> 8) & 0xFFFFFF) / (float) (1UL << 24);
+    int from = 0, to = KEYS - 1;
+    while (from < to) {                                             // binary search for the first cdf [k] >= u
+        int middle = (from + to) / 2;
+        if (cdf [middle] < u)
+            from = middle + 1;
+        else
+            to = middle;
+    }
+    return from * 7919L;                                            // spread the keys a little
+}
+
+
+void setup () {
+
+    cinit ();                                                       // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    initZipf ();
+    if (!cdf) {
+        cout << "out of memory, please decrease KEYS\n";
+        return;
+    }
+
+    unsigned long seed;
+    unsigned long t;
+
+    cout << "----- " << ACCESSES << " Zipfian accesses to " << KEYS << " keys, cache of " << CAPACITY << " pairs -----\n";
+
+    // lru_cache: get, put on a miss
+    lru_cache<long, long> cache (CAPACITY);
+    seed = 1;
+    t = micros ();
+        for (long i = 0; i < ACCESSES; i++) {
+            long key = nextZipfKey (seed);
+            if (!cache.get (key))
+                cache.put (key, i);                                 // O (1) eviction of the least recently used pair
+        }
+    t = micros () - t;
+    cout << "lru_cache:             " << t << " us, hit ratio " << (float) cache.hits () / ACCESSES << ", " << cache.evictions () << " evictions\n";
+
+    // Map with time stamps: get, put on a miss, the oldest pair is found by scanning all of them
+    struct entry {
+        long value;
+        unsigned long lastUsed;
+    };
+    Map<long, entry> M;
+    unsigned long hits = 0;
+    unsigned long evictions = 0;
+    seed = 1;
+    t = micros ();
+        for (long i = 0; i < ACCESSES; i++) {
+            long key = nextZipfKey (seed);
+            entry *e = M.get_if (key);
+            if (e) {
+                e->lastUsed = i;
+                hits ++;
+            } else {
+                if (M.size () >= CAPACITY) {                        // O (n) scan for the least recently used pair
+                    long oldestKey = 0;
+                    unsigned long oldest = (unsigned long) -1;
+                    for (auto& p: M)
+                        if (p.second.lastUsed < oldest) {
+                            oldest = p.second.lastUsed;
+                            oldestKey = p.first;
+                        }
+                    M.erase (oldestKey);
+                    evictions ++;
+                }
+                M.insert (key, { i, (unsigned long) i });
+            }
+        }
+    t = micros () - t;
+    cout << "Map + time stamp scan: " << t << " us, hit ratio " << (float) hits / ACCESSES << ", " << evictions << " evictions\n";
+
+    if ((cache.errorFlags () | M.errorFlags ()) & err_bad_alloc)
+        cout << "out of memory, please decrease KEYS\n";
+
+    free (cdf);
+}
+
+void loop () {
+
+}
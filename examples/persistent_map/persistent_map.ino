@@ -0,0 +1,63 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+
+#include <persistent_map.hpp> // maps with copy-on-write snapshots, error handling and ability to use PSRAM for Arduino
+
+
+persistent_map<String, String> config = { {"ssid", "home"}, {"hostname", "esp32"}, {"ntp", "pool.ntp.org"} };
+
+
+// This would run in the web server task: it takes a snapshot and reads it without locking, while the control loop may change the config
+void printConfig () {
+    persistent_map<String, String> view = config.snapshot ();
+    cout << "config: " << view << endl;
+}
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    persistent_map<String, String> before = config.snapshot ();
+
+    // The control loop changes the config, each change publishes a new version that shares all the unchanged nodes with the previous one
+    if (config.insert_or_assign ("ssid", "office") != err_ok)
+        cout << "insert_or_assign failed due to memory issue\n";
+    config.erase ("ntp");
+    config.insert ("timezone", "CET-1CEST");
+
+    // The snapshot taken before still sees the old version
+    auto p = before.find ("ssid");
+    if (p)
+        cout << "ssid before: " << p->second << endl;
+    printConfig ();
+
+
+    // Taking a snapshot doesn't depend on the number of pairs, copying a Map does
+    #define PAIRS 1000
+    Map<int, int> mp;
+    for (int i = 0; i < PAIRS; i++)
+        mp [i] = i;
+    persistent_map<int, int> pm (mp);                         // built directly from Map's sorted pairs
+
+    unsigned long start = micros ();
+    Map<int, int> mpCopy = mp;
+    cout << "copying Map of " << mpCopy.size () << " pairs: " << (micros () - start) << " us\n";
+
+    start = micros ();
+    persistent_map<int, int> pmSnapshot = pm.snapshot ();
+    cout << "snapshot of persistent_map of " << pmSnapshot.size () << " pairs: " << (micros () - start) << " us\n";
+
+    start = micros ();
+    for (int i = 0; i < 100; i++)
+        pm.insert_or_assign (i * 10, -i);                     // copies only the nodes on the path to the pair
+    cout << "100 updates with a snapshot alive: " << (micros () - start) << " us, the snapshot still has " << pmSnapshot.find (10)->second << " for key 10\n";
+}
+
+void loop () {
+
+}
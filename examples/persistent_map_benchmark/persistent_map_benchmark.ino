@@ -0,0 +1,140 @@
+// #define MAP_MEMORY_TYPE PSRAM_MEM // uncomment this line if you want persistent_map and Map to use PSRAM instead of heap (ESP32 boards with PSRAM only)
+
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Map.hpp>          // balanced binary search tree with error handling and ability to use PSRAM for Arduino
+#include <persistent_map.hpp> // maps with copy-on-write snapshots for Arduino
+
+#include <thread>           // std::thread runs as a FreeRTOS task on ESP32 boards, this benchmark doesn't run on AVR boards
+#include <mutex>
+#include <atomic>
+
+
+#define KEYS 1000
+#define UPDATES 20000       // made by the writer thread
+#define READERS 4           // threads that read all the pairs over and over again while the writer is changing them
+
+
+// the writer only increases the values, so each version of the pairs checks the following:
+//   - there are KEYS pairs, the keys are 0 .. KEYS - 1 in order,
+//   - value of key k is 0 or an update number u with u % KEYS == k,
+//   - the sum of values doesn't change while the version is being read and doesn't decrease from one version to the next
+
+struct readerResult {
+    long versions;          // number of versions read
+    long errors;            // number of failed checks
+};
+
+std::atomic<bool> writing;
+
+
+// one Map shared by the writer and the readers through one mutex - the way it had to be done before, the readers lock the writer out while they read
+Map<int, long> lockedMap;
+std::mutex lockedMapMutex;
+
+void lockedMapWriter () {
+    for (long u = 1; u <= UPDATES; u++) {
+        std::lock_guard<std::mutex> guard (lockedMapMutex);
+        lockedMap.insert_or_assign ((int) (u % KEYS), u);
+    }
+    writing = false;
+}
+
+void lockedMapReader (readerResult *r) {
+    long lastSum = 0;
+    while (writing) {
+        long sum = 0;
+        int k = 0;
+        {
+            std::lock_guard<std::mutex> guard (lockedMapMutex);
+            for (auto& e : lockedMap) {
+                if (e.first != k ++ || (e.second != 0 && e.second % KEYS != e.first))
+                    r->errors ++;
+                sum += e.second;
+            }
+        }
+        if (k != KEYS || sum < lastSum)
+            r->errors ++;
+        lastSum = sum;
+        r->versions ++;
+    }
+}
+
+
+// persistent_map: the readers take snapshots and read them without locking while the writer keeps publishing new versions
+persistent_map<int, long> sharedMap;
+
+void persistentMapWriter () {
+    for (long u = 1; u <= UPDATES; u++)
+        sharedMap.insert_or_assign ((int) (u % KEYS), u);
+    writing = false;
+}
+
+long sumOf (const persistent_map<int, long>& view, readerResult *r) {
+    long sum = 0;
+    int k = 0;
+    for (auto& e : view) {
+        if (e.first != k ++ || (e.second != 0 && e.second % KEYS != e.first))
+            r->errors ++;
+        sum += e.second;
+    }
+    if (k != KEYS)
+        r->errors ++;
+    return sum;
+}
+
+void persistentMapReader (readerResult *r) {
+    long lastSum = 0;
+    while (writing) {
+        persistent_map<int, long> view = sharedMap.snapshot ();
+        long sum = sumOf (view, r);
+        if (sum != sumOf (view, r) || sum < lastSum) // the writer doesn't change the snapshot while it is being read
+            r->errors ++;
+        lastSum = sum;
+        r->versions ++;
+    }
+}
+
+
+// runs the writer and the readers and prints the results
+void run (const char *name, void (*writer) (), void (*reader) (readerResult *)) {
+    std::thread *t [READERS];
+    readerResult results [READERS] = {};
+    writing = true;
+    unsigned long start = micros ();
+    for (int i = 0; i < READERS; i++)
+        t [i] = new std::thread (reader, &results [i]);
+    std::thread w (writer);
+    w.join ();
+    unsigned long us = micros () - start;
+    long versions = 0;
+    long errors = 0;
+    for (int i = 0; i < READERS; i++) {
+        t [i]->join ();
+        delete t [i];
+        versions += results [i].versions;
+        errors += results [i].errors;
+    }
+    cout << name << ": " << UPDATES << " updates in " << us << " us while " << READERS << " readers read " << versions << " versions, errors: " << errors << endl;
+}
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    for (int i = 0; i < KEYS; i++) {
+        lockedMap.insert (i, 0);
+        sharedMap.insert (i, 0);
+    }
+    if (lockedMap.errorFlags () || sharedMap.errorFlags ())
+        cout << "insert failed due to memory issue\n";
+
+    run ("Map + mutex   ", lockedMapWriter, lockedMapReader);
+    run ("persistent_map", persistentMapWriter, persistentMapReader);
+    if (sharedMap.errorFlags ())
+        cout << "insert_or_assign failed due to memory issue\n";
+}
+
+void loop () {
+
+}
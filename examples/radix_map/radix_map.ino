@@ -0,0 +1,70 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+
+#include <radix_map.hpp>    // radix trees of string keys with error handling and ability to use PSRAM for Arduino
+
+
+void onRoot (const char *path) { cout << "home page for " << path << endl; }
+void onApi (const char *path) { cout << "API call " << path << endl; }
+void onStatus (const char *path) { cout << "status page for " << path << endl; }
+
+void printTopic (const char *topic, float& value) { cout << "   " << topic << " = " << value << endl; }
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // URL routing: the handler of the longest route that is a prefix of the path is called
+    radix_map<void (*) (const char *)> routes;
+    routes.insert ("/", onRoot);
+    routes.insert ("/api/", onApi);
+    routes.insert ("/api/status", onStatus);
+
+    const char *paths [] = { "/index.html", "/api/wifi/scan", "/api/status/uptime" };
+    for (const char *path : paths) {
+        auto handler = routes.longest_prefix (path);
+        if (handler)
+            (*handler) (path);
+    }
+
+    // Topics: all the topics under a prefix are visited in alphabetical order
+    radix_map<float> topics;
+    topics.insert ("home/livingroom/temperature", 22.5);
+    topics.insert ("home/livingroom/humidity", 41);
+    topics.insert ("home/kitchen/temperature", 24);
+    topics.insert ("home/kitchen/smoke", 0);
+    if (topics.insert ("home/kitchen/smoke", 1) == err_not_unique)
+        cout << "home/kitchen/smoke is already there\n";
+
+    cout << "home/livingroom/:\n";
+    topics.for_each_prefix ("home/livingroom/", printTopic);
+
+    float *t = topics.find ("home/kitchen/temperature");
+    if (t)
+        cout << "kitchen temperature: " << *t << endl;
+
+    topics.erase ("home/kitchen/smoke");
+    cout << "all the topics:\n";
+    topics.for_each (printTopic);
+
+    // The common prefixes are stored only once
+    size_t keyBytes = 0;
+    radix_map<int> devices;
+    for (int i = 0; i < 100; i++) {
+        char s [40];
+        sprintf (s, "home/sensors/device_%03i/state", i);
+        if (devices.insert (s, i) != err_ok)
+            cout << "insert failed due to memory issue\n";
+        keyBytes += strlen (s) + 1;
+    }
+    cout << devices.size () << " keys of " << keyBytes << " characters take " << devices.bytes () << " bytes together with the values\n";
+}
+
+void loop () {
+
+}
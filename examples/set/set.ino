@@ -0,0 +1,53 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+
+#include <set.hpp>          // set, multiset and multimap with error handling and ability to use PSRAM for Arduino
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // A set of unique ids, the nodes hold only the keys
+    set<int> ids = { 7, 3, 5 };
+    ids.insert (4);
+    if (ids.insert (5) == err_not_unique)
+        cout << "5 is already there\n";
+    ids.erase (3);
+    cout << "ids: " << ids << endl;
+    if (ids.contains (7))
+        cout << "7 is there\n";
+
+    // A multiset counts equal keys
+    multiset<int> temperatures = { 21, 22, 21, 23, 21 };
+    cout << "21 was measured " << temperatures.count (21) << " times\n";
+
+    // Erase while iterating, erase (iterator) returns the iterator to the next element
+    for (auto it = temperatures.begin (); it != temperatures.end (); )
+        if (*it > 22)
+            it = temperatures.erase (it);
+        else
+            ++ it;
+    cout << "temperatures: " << temperatures << endl;
+
+    // A multimap keeps the values with equal keys in the order they were inserted, without a nested list for each key
+    multimap<String, String> routes;
+    routes.insert ("/", "index.html");
+    routes.insert ("/", "index.htm");
+    if (routes.insert ("/about", "about.html") != err_ok)
+        cout << "insert failed due to memory issue\n";
+
+    for (auto& pair: routes.equal_range ("/"))
+        cout << pair.first << " -> " << pair.second << endl;
+
+    routes.erase ("/"); // all the pairs with the key
+    cout << "routes: " << routes << endl;
+}
+
+void loop () {
+
+}
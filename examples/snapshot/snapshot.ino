@@ -0,0 +1,142 @@
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Cstring.hpp>      // C strings that use stack memory, with C++ operators, UTF-8 awareness and error handling for Arduino
+#include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+#include <vector.hpp>       // vectors with error handling and ability to use PSRAM for Arduino
+
+
+#ifdef ARDUINO_ARCH_AVR
+    #define N 20            // AVR boards don't have much memory
+#else
+    #define N 2000
+#endif
+
+
+struct config_t {
+    int port;
+    float threshold;
+    bool enabled;
+};
+
+struct calibration_t {
+    float offset;
+    float gain;
+};
+
+
+// save and load work with any Arduino Stream (File, Serial, ...), for this benchmark the snapshot is kept in memory, so it runs on any board
+class memoryStream {
+
+    public:
+
+        memoryStream (size_t size) { __buffer__ = (uint8_t *) malloc (size); __size__ = __buffer__ ? size : 0; }
+        ~memoryStream () { free (__buffer__); }
+
+        size_t write (const uint8_t *buffer, size_t size) {
+            if (__written__ + size > __size__)
+                return 0;
+            memcpy (__buffer__ + __written__, buffer, size);
+            __written__ += size;
+            return size;
+        }
+
+        size_t readBytes (char *buffer, size_t size) {
+            if (__read__ + size > __written__)
+                size = __written__ - __read__;
+            memcpy (buffer, __buffer__ + __read__, size);
+            __read__ += size;
+            return size;
+        }
+
+        size_t length () { return __written__; }
+        void rewind () { __read__ = 0; }
+
+    private:
+
+        uint8_t *__buffer__;
+        size_t __size__;
+        size_t __written__ = 0;
+        size_t __read__ = 0;
+};
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    unsigned long t;
+
+    cout << "----- Map<Cstring<32>, config_t> of " << N << " pairs -----\n";
+
+    // the slow way: parse the configuration text line by line
+    Map<Cstring<32>, config_t> config;
+    char line [64];
+    t = micros ();
+        for (int i = 0; i < N; i++) {
+            sprintf (line, "sensor_%i %i %i.5 %i", (i * 7919) % N, 8000 + i, i % 100, i % 2); // this line would normally be read from a text file
+            char name [32];
+            int port, threshold, enabled;
+            sscanf (line, "%31s %i %i.5 %i", name, &port, &threshold, &enabled);
+            config.insert (name, { port, threshold + 0.5f, enabled != 0 });
+        }
+    t = micros () - t;
+    cout << "parse text:        " << t << " us (height " << config.height () << ")\n";
+
+    memoryStream snapshot (16 + N * (sizeof (Cstring<32>) + sizeof (config_t)) + 4);
+    t = micros ();
+        signed char e = config.save (snapshot);
+    t = micros () - t;
+    cout << "save:              " << t << " us (" << snapshot.length () << " bytes)\n";
+
+    Map<Cstring<32>, config_t> loadedConfig;
+    t = micros ();
+        if (e == err_ok)
+            e = loadedConfig.load (snapshot);                   // one block of nodes, pairs are read directly into them, the balanced tree is linked in O (n)
+    t = micros () - t;
+    cout << "load:              " << t << " us (height " << loadedConfig.height () << ")\n";
+    if (e != err_ok)
+        cout << "snapshot error " << e << endl;
+
+    auto c = loadedConfig.find ("sensor_42");
+    if (c != loadedConfig.end ())
+        cout << c->first << " listens on port " << c->second.port << endl;
+
+    cout << "----- vector<calibration_t> of " << N << " elements -----\n";
+
+    vector<calibration_t> calibration;
+    for (int i = 0; i < N; i++)
+        calibration.push_back ({ (float) i / 10, 1 + (float) i / 1000 });
+
+    memoryStream calibrationSnapshot (16 + N * sizeof (calibration_t) + 4);
+    t = micros ();
+        e = calibration.save (calibrationSnapshot);
+    t = micros () - t;
+    cout << "save:              " << t << " us (" << calibrationSnapshot.length () << " bytes)\n";
+
+    vector<calibration_t> loadedCalibration;
+    t = micros ();
+        if (e == err_ok)
+            e = loadedCalibration.load (calibrationSnapshot);   // all the elements are read at once
+    t = micros () - t;
+    cout << "load:              " << t << " us (" << loadedCalibration.size () << " elements)\n";
+    if (e != err_ok)
+        cout << "snapshot error " << e << endl;
+
+    /* with a file system it would look like:
+
+        #include <LittleFS.h>
+
+        LittleFS.begin (true);
+        File f = LittleFS.open ("/config.bin", "w");
+        config.save (f);
+        f.close ();
+        ...
+        f = LittleFS.open ("/config.bin", "r");
+        if (!f || config.load (f) != err_ok)
+            // parse the text configuration
+        f.close ();
+    */
+}
+
+void loop () {
+
+}
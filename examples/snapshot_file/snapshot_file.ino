@@ -0,0 +1,210 @@
+#include <ostream.hpp>      // cout instance for Arduino
+#include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+#include <vector.hpp>       // vectors with error handling and ability to use PSRAM for Arduino
+
+#include <stdio.h>          // save and load also work with FILE *, on Linux or on ESP32 file systems mounted in VFS
+
+
+#ifdef ARDUINO_ARCH_ESP32
+    #include <LittleFS.h>
+    #define SNAPSHOT_FILE   "/littlefs/snapshot.bin"   // LittleFS is mounted in VFS at /littlefs
+    #define DAMAGED_FILE    "/littlefs/damaged.bin"
+#else
+    #define SNAPSHOT_FILE   "/tmp/snapshot.bin"
+    #define DAMAGED_FILE    "/tmp/damaged.bin"
+#endif
+
+#define N 5000
+
+
+// prints the result of a test, err_bad_data (-112) is expected for damaged snapshots
+void check (const char *test, signed char e, signed char expected) {
+    cout << test << ": " << e << (e == expected ? " - OK\n" : " - FAILED\n");
+}
+
+// copies size bytes of the snapshot to DAMAGED_FILE, flipping the bits of the byte at position damage (if it is inside the copied bytes)
+void damage (size_t size, long damage) {
+    FILE *in = fopen (SNAPSHOT_FILE, "rb");
+    FILE *out = fopen (DAMAGED_FILE, "wb");
+    if (in != NULL && out != NULL)
+        for (size_t i = 0; i < size; i++) {
+            int c = fgetc (in);
+            if (c == EOF)
+                break;
+            fputc ((long) i == damage ? c ^ 0xFF : c, out);
+        }
+    if (in != NULL)
+        fclose (in);
+    if (out != NULL)
+        fclose (out);
+}
+
+long fileSize (const char *name) {
+    FILE *f = fopen (name, "rb");
+    if (f == NULL)
+        return 0;
+    fseek (f, 0, SEEK_END);
+    long size = ftell (f);
+    fclose (f);
+    return size;
+}
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    #ifdef ARDUINO_ARCH_ESP32
+        LittleFS.begin (true);
+    #endif
+
+    unsigned long t;
+    FILE *f;
+    signed char e;
+
+    cout << "----- Map<String, int> of " << N << " pairs -----\n";
+
+    Map<String, int> counters;
+    for (int i = 0; i < N; i++)
+        counters.insert (String ("counter_") + String ((i * 7919) % N), i);
+
+    f = fopen (SNAPSHOT_FILE, "wb");
+    t = micros ();
+        e = f != NULL ? counters.save (f) : err_bad_data;
+    t = micros () - t;
+    if (f != NULL)
+        fclose (f);
+    cout << "save:              " << t << " us (" << fileSize (SNAPSHOT_FILE) << " bytes)\n";
+    check ("save Map", e, err_ok);
+
+    Map<String, int> loadedCounters;
+    f = fopen (SNAPSHOT_FILE, "rb");
+    t = micros ();
+        e = f != NULL ? loadedCounters.load (f) : err_bad_data;
+    t = micros () - t;
+    if (f != NULL)
+        fclose (f);
+    cout << "load:              " << t << " us (height " << loadedCounters.height () << ")\n";
+    check ("load Map", e, err_ok);
+    bool same = loadedCounters.size () == counters.size ();
+    for (auto p : counters)
+        if (!loadedCounters.contains (p.first) || loadedCounters [p.first] != p.second)
+            same = false;
+    check ("loaded Map equals saved Map", same ? err_ok : err_bad_data, err_ok);
+
+    // damaged snapshots are rejected
+    long size = fileSize (SNAPSHOT_FILE);
+
+    damage (size, size / 2);                                  // one byte in the middle of the records is changed
+    Map<String, int> corrupted;
+    f = fopen (DAMAGED_FILE, "rb");
+    e = f != NULL ? corrupted.load (f) : err_ok;
+    if (f != NULL)
+        fclose (f);
+    check ("load corrupted Map", e, err_bad_data);
+
+    damage (size / 2, -1);                                    // the second half of the snapshot is missing
+    Map<String, int> truncated;
+    f = fopen (DAMAGED_FILE, "rb");
+    e = f != NULL ? truncated.load (f) : err_ok;
+    if (f != NULL)
+        fclose (f);
+    check ("load truncated Map", e, err_bad_data);
+
+    Map<int, int> wrongType;                                  // key size in the header doesn't match
+    f = fopen (SNAPSHOT_FILE, "rb");
+    e = f != NULL ? wrongType.load (f) : err_ok;
+    if (f != NULL)
+        fclose (f);
+    check ("load Map<String, int> into Map<int, int>", e, err_bad_data);
+
+    cout << "----- vector<int> of " << N << " elements -----\n";
+
+    vector<int> readings;
+    for (int i = 0; i < N; i++)
+        readings.push_back (i * i);
+
+    f = fopen (SNAPSHOT_FILE, "wb");
+    t = micros ();
+        e = f != NULL ? readings.save (f) : err_bad_data;
+    t = micros () - t;
+    if (f != NULL)
+        fclose (f);
+    cout << "save:              " << t << " us (" << fileSize (SNAPSHOT_FILE) << " bytes)\n";
+    check ("save vector<int>", e, err_ok);
+
+    vector<int> loadedReadings;
+    f = fopen (SNAPSHOT_FILE, "rb");
+    t = micros ();
+        e = f != NULL ? loadedReadings.load (f) : err_bad_data;
+    t = micros () - t;
+    if (f != NULL)
+        fclose (f);
+    cout << "load:              " << t << " us (" << loadedReadings.size () << " elements)\n";
+    check ("load vector<int>", e, err_ok);
+    same = loadedReadings.size () == readings.size ();
+    for (size_t i = 0; same && i < readings.size (); i++)
+        same = loadedReadings [i] == readings [i];
+    check ("loaded vector<int> equals saved vector<int>", same ? err_ok : err_bad_data, err_ok);
+
+    size = fileSize (SNAPSHOT_FILE);
+    damage (size, 20);                                        // the first record is changed
+    vector<int> corruptedReadings;
+    f = fopen (DAMAGED_FILE, "rb");
+    e = f != NULL ? corruptedReadings.load (f) : err_ok;
+    if (f != NULL)
+        fclose (f);
+    check ("load corrupted vector<int>", e, err_bad_data);
+
+    vector<double> wrongReadings;                             // element size in the header doesn't match
+    f = fopen (SNAPSHOT_FILE, "rb");
+    e = f != NULL ? wrongReadings.load (f) : err_ok;
+    if (f != NULL)
+        fclose (f);
+    check ("load vector<int> into vector<double>", e, err_bad_data);
+
+    cout << "----- vector<String> of " << N << " elements -----\n";
+
+    vector<String> names;
+    for (int i = 0; i < N; i++)
+        names.push_back (String ("sensor_") + String (i));
+
+    f = fopen (SNAPSHOT_FILE, "wb");
+    t = micros ();
+        e = f != NULL ? names.save (f) : err_bad_data;
+    t = micros () - t;
+    if (f != NULL)
+        fclose (f);
+    cout << "save:              " << t << " us (" << fileSize (SNAPSHOT_FILE) << " bytes)\n";
+    check ("save vector<String>", e, err_ok);
+
+    vector<String> loadedNames;
+    f = fopen (SNAPSHOT_FILE, "rb");
+    t = micros ();
+        e = f != NULL ? loadedNames.load (f) : err_bad_data;
+    t = micros () - t;
+    if (f != NULL)
+        fclose (f);
+    cout << "load:              " << t << " us (" << loadedNames.size () << " elements)\n";
+    check ("load vector<String>", e, err_ok);
+    same = loadedNames.size () == names.size ();
+    for (size_t i = 0; same && i < names.size (); i++)
+        same = loadedNames [i] == names [i];
+    check ("loaded vector<String> equals saved vector<String>", same ? err_ok : err_bad_data, err_ok);
+
+    size = fileSize (SNAPSHOT_FILE);
+    damage (size - 1, -1);                                    // the last byte of the checksum is missing
+    vector<String> truncatedNames;
+    f = fopen (DAMAGED_FILE, "rb");
+    e = f != NULL ? truncatedNames.load (f) : err_ok;
+    if (f != NULL)
+        fclose (f);
+    check ("load truncated vector<String>", e, err_bad_data);
+
+    remove (SNAPSHOT_FILE);
+    remove (DAMAGED_FILE);
+}
+
+void loop () {
+
+}
@@ -0,0 +1,66 @@
+#include <ostream.hpp>      // cout instance for Arduino
+
+/* place all the internal memory structures into PSRAM if it is installed on the bord
+    #define MAP_MEMORY_TYPE           PSRAM_MEM
+    bool psramused = psramInit ();
+*/
+/* let the table fill up more before it grows (uses less memory but collisions get more expensive), the default is 0.8
+    #define UNORDERED_MAP_MAX_LOAD_FACTOR 0.9
+*/
+
+#include <unordered_map.hpp> // hash tables with error handling and ability to use PSRAM for Arduino
+
+
+void setup () {
+
+    cinit ();                                                 // three optional arguments: bool waitForSerial = false, unsigned int waitAfterSerial = 100 [ms], unsigned int serialSpeed = 115200 (9600 for AVR boards)
+
+    // Create and initialize unordered map with some topics and their handlers' ids, the keys don't need to be ordered, so a hash table is faster than Map
+    unordered_map<String, int> topicHandler ( { {"home/livingroom/temperature", 1},  {"home/kitchen/temperature", 1}, {"home/door", 2} } );
+
+    // Perform some operations, like inserting additional pairs 
+    topicHandler.insert ("home/garage/door", 2);
+    // or use []
+    topicHandler ["home/garden/humidity"] = 3;
+
+    // Check success of each individual operation
+    switch (topicHandler.insert ("home/door", 4)) {
+        case err_bad_alloc: 
+                            cout << "insert failed due to memory issue\n";
+                            break;
+        case err_not_unique:
+                            cout << "the key already exists\n";
+                            break;
+    }
+    topicHandler.clearErrorFlags ();
+
+    // Find the handler for a topic
+    auto it = topicHandler.find ("home/garage/door");
+    if (it != topicHandler.end ())
+        cout << it->first << " is handled by " << it->second << endl;
+
+    topicHandler.erase ("home/door");
+
+    cout << "There are " << topicHandler.size () << " pairs in " << topicHandler.bucket_count () << " slots (load factor " << topicHandler.load_factor () << ")\n";
+    // Use iterator to scan the pairs (in no particular order)
+    for (auto& pair: topicHandler)
+        cout << pair.first << " - " << pair.second << endl;
+
+    // Make room for 100 pairs in advance so the table doesn't need to grow while they are beeing inserted
+    unordered_map<int, int> deviceState;
+    if (deviceState.reserve (100) == err_ok)
+        for (int id = 0; id < 100; id ++)
+            deviceState [id] = id % 3;
+    cout << "There are " << deviceState.size () << " pairs in " << deviceState.bucket_count () << " slots\n";
+
+    // Numbers that are searched for are converted to the key type first, so they hash the same as the keys: an int finds a long key
+    unordered_map<long, int> sessionOwner;
+    sessionOwner [5L] = 1;
+    sessionOwner [5] = 2;                                     // the same pair
+    if (sessionOwner.contains (5))
+        cout << "session 5 is owned by " << sessionOwner [5] << " (" << sessionOwner.size () << " pair)\n";
+}
+
+void loop () {
+
+}
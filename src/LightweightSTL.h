@@ -4,8 +4,20 @@
 #include <Cstring.hpp>      // C strings that use stack memory, with C++ operators, UTF-8 awareness and error handling for Arduino
 #include <array.hpp>        // arrays for Arduino
 #include <list.hpp>         // single linked lists with error handling and ability to use PSRAM for Arduino
+#include <dlist.hpp>        // double linked lists with error handling and ability to use PSRAM for Arduino
+#include <intrusive_list.hpp> // lists of objects that embed their own links, no memory allocation
+#include <unrolled_list.hpp> // lists with more elements per node, with error handling and ability to use PSRAM for Arduino
 #include <vector.hpp>       // vectors with error handling and ability to use PSRAM for Arduino
 #include <queue.hpp>        // queues with error handling and ability to use PSRAM for Arduino
 #include <Map.hpp>          // maps with error handling and ability to use PSRAM for Arduino
+#include <compact_map.hpp>  // maps with compact nodes (16 or 32-bit indexes instead of pointers) for many small pairs
+#include <set.hpp>          // sets, multisets and multimaps with error handling and ability to use PSRAM for Arduino
+#include <unordered_map.hpp> // hash tables with error handling and ability to use PSRAM for Arduino
+#include <btree_map.hpp>    // B-trees with error handling and ability to use PSRAM for Arduino
+#include <lru_cache.hpp>    // least recently used caches with error handling and ability to use PSRAM for Arduino
+#include <persistent_map.hpp> // maps with copy-on-write snapshots for concurrent readers, error handling and ability to use PSRAM for Arduino
+#include <concurrent_map.hpp> // sharded maps with reader-writer locks that different tasks can use at the same time
+#include <radix_map.hpp>    // radix trees of string keys with prefix lookups, error handling and ability to use PSRAM for Arduino
+#include <atom.hpp>         // interned strings that compare in O (1), with error handling and ability to use PSRAM for Arduino
 #include <algorithm.hpp>    // find, heap sort for vectors, ... merge sort for lists
 #include <complex.hpp>      // complex numbers for Arduino
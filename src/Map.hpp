@@ -18,10 +18,20 @@
 
     // ----- TUNNING PARAMETERS -----
 
-    #define __MAP_MAX_STACK_SIZE__ 32 // statically allocated stack needed for iterating through elements, 24 should be enough for the number of elemetns that fit into ESP32's memory
-
     // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want Map to throw exceptions
 
+    #ifndef MAP_NODES_PER_SLAB
+        #ifdef ARDUINO_ARCH_AVR
+            #define MAP_NODES_PER_SLAB 4    // maximum number of nodes Map's node pool allocates at once, keep it small on AVR boards
+        #else
+            #define MAP_NODES_PER_SLAB 32   // maximum number of nodes Map's node pool allocates at once
+        #endif
+    #endif
+
+    // #define MAP_ORDER_STATISTICS // uncomment this line if you want Map nodes to keep the sizes of their subtrees, this enables rank, select and nth functions in O (log n) time
+
+    // #define MAP_SHARED_NODE_POOL // uncomment this line if you want all Maps with the same node size to share one node pool (a Map then can't be used by different tasks at the same time than any other Map sharing the pool)
+
 
     // error flags: there are only two types of error flags that can be set: OVERFLOW and OUT_OF_RANGE - please note that all errors are negative (char) numbers
     #define err_ok              ((signed char) 0b00000000)  //    0 - no error
@@ -38,7 +48,430 @@
     #endif
 
 
-    template <class keyType, class valueType> class Map {
+    #include "snapshot.hpp" // binary save and load
+
+
+    /*
+     *  Map's node pool: nodes are allocated in slabs of nodes of the same size, deleted nodes are kept in a free list and reused,
+     *  so the Maps that often insert and erase pairs don't call malloc and free for each node and don't fragment the memory (PSRAM).
+     *  The first slab holds only 1 node and each next one as many nodes as all the slabs before, up to MAP_NODES_PER_SLAB (or blocksPerSlab) nodes,
+     *  so small Maps (and the shards of concurrent_map, lru_caches, sets, ...) don't allocate memory for the nodes they will never use.
+     *
+     *  The slabs are released only when the last node is returned to the pool (by erasing all the pairs, clear or destructor), the memory of
+     *  erased nodes is kept for the nodes that will be inserted later. A Map that grew large and then shrank still occupies its largest size,
+     *  call clear () or copy the remaining pairs into a new Map if this memory is needed elsewhere.
+     */
+
+    template <size_t blockSize, size_t blocksPerSlab = MAP_NODES_PER_SLAB> class __mapNodePool__ {
+
+        public:
+
+            // there is no destructor, Maps return all their nodes before they are destroyed, and this is when the slabs get released
+
+            void *allocate () {
+                if (__freeList__ == NULL) { // allocate a new slab and put all its blocks into the free list
+                    size_t n = __capacity__ == 0 ? 1 : (__capacity__ < blocksPerSlab ? __capacity__ : blocksPerSlab);
+                    #if MAP_MEMORY_TYPE == PSRAM_MEM
+                        __slab__ *s = (__slab__ *) ps_malloc (offsetof (__slab__, block) + n * sizeof (__block__));
+                    #else
+                        __slab__ *s = (__slab__ *) malloc (offsetof (__slab__, block) + n * sizeof (__block__));
+                    #endif
+                    if (s == NULL)
+                        return NULL;
+                    s->next = __slabs__;
+                    __slabs__ = s;
+                    __capacity__ += n;
+                    for (int i = n - 1; i >= 0; i--) {
+                        s->block [i].nextFree = __freeList__;
+                        __freeList__ = &s->block [i];
+                    }
+                }
+                __block__ *b = __freeList__;
+                __freeList__ = b->nextFree;
+                __blocksInUse__ ++;
+                return b;
+            }
+
+            // allocates n blocks in one slab and returns the first one, the blocks follow each other stride () bytes apart, they are returned to the pool one by one, like any other block
+            void *allocate (size_t n) {
+                #if MAP_MEMORY_TYPE == PSRAM_MEM
+                    __slab__ *s = (__slab__ *) ps_malloc (offsetof (__slab__, block) + n * sizeof (__block__));
+                #else
+                    __slab__ *s = (__slab__ *) malloc (offsetof (__slab__, block) + n * sizeof (__block__));
+                #endif
+                if (s == NULL)
+                    return NULL;
+                s->next = __slabs__;
+                __slabs__ = s;
+                __capacity__ += n;
+                __blocksInUse__ += n;
+                return &s->block [0];
+            }
+
+            static size_t stride () { return sizeof (__block__); }
+
+            void deallocate (void *p) {
+                __block__ *b = (__block__ *) p;
+                b->nextFree = __freeList__;
+                __freeList__ = b;
+                if (-- __blocksInUse__ == 0)
+                    __releaseSlabs__ ();
+            }
+
+            // the pool shared by all Maps whose nodes are of the same size
+            static __mapNodePool__& shared () {
+                static __mapNodePool__ sharedPool;
+                return sharedPool;
+            }
+
+        private:
+
+            union __block__ {
+                __block__ *nextFree;    // used while the block is free
+                char data [blockSize];  // used while the block holds a node
+                long long alignLongLong;
+                double alignDouble;
+            };
+
+            struct __slab__ {
+                __slab__ *next;
+                __block__ block [blocksPerSlab];
+            };
+
+            __slab__ *__slabs__ = NULL;
+            __block__ *__freeList__ = NULL;
+            size_t __blocksInUse__ = 0;
+            size_t __capacity__ = 0;    // blocks in all the slabs
+
+            void __releaseSlabs__ () {
+                while (__slabs__) {
+                    __slab__ *s = __slabs__;
+                    __slabs__ = s->next;
+                    free (s);
+                }
+                __freeList__ = NULL;
+                __capacity__ = 0;
+            }
+    };
+
+
+    // keys that are searched for (probes) are compared and hashed as they are, so Strings can be found by C strings and Cstrings without constructing temporary Strings,
+    // only numbers are converted to keyType first, so they find the same keys as keyType would: Map<unsigned long, float>::find (1), unordered_map<long, int>::contains (5)
+    #ifndef __MAP_PROBE__
+        #define __MAP_PROBE__
+        template <class T> struct __mapIsNumber__ { static const bool value = false; };
+        template <> struct __mapIsNumber__<bool> { static const bool value = true; };
+        template <> struct __mapIsNumber__<char> { static const bool value = true; };
+        template <> struct __mapIsNumber__<signed char> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned char> { static const bool value = true; };
+        template <> struct __mapIsNumber__<short> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned short> { static const bool value = true; };
+        template <> struct __mapIsNumber__<int> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned int> { static const bool value = true; };
+        template <> struct __mapIsNumber__<long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<long long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned long long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<float> { static const bool value = true; };
+        template <> struct __mapIsNumber__<double> { static const bool value = true; };
+        template <> struct __mapIsNumber__<long double> { static const bool value = true; };
+
+        template <class keyType, class K, bool isNumber = __mapIsNumber__<K>::value> struct __mapProbe__ { static const K& key (const K& k) { return k; } };
+        template <class keyType, class K> struct __mapProbe__<keyType, K, true> { static keyType key (const K& k) { return k; } };
+    #endif
+
+
+    // Cstring keys are compared and hashed by their characters regardless of whether Cstring.hpp is included before or after this file
+    template <size_t N> struct Cstring;
+
+    // key comparison used by btree_map, set, multiset and multimap, the other key can be of any type comparable to keyType, Strings are compared with C strings and Cstrings without constructing temporary Strings
+    template <class A, class B> inline bool __mapLess__ (const A& a, const B& b) { return a < b; }
+    inline bool __mapLess__ (const String& a, const char *b) { return strcmp (a.c_str (), b) < 0; }
+    inline bool __mapLess__ (const char *a, const String& b) { return strcmp (a, b.c_str ()) < 0; }
+    template <size_t N> inline bool __mapLess__ (const String& a, const Cstring<N>& b) { return strcmp (a.c_str (), b.c_str ()) < 0; }
+    template <size_t N> inline bool __mapLess__ (const Cstring<N>& a, const String& b) { return strcmp (a.c_str (), b.c_str ()) < 0; }
+    template <size_t N> inline bool __mapLess__ (const char *a, const Cstring<N>& b) { return strcmp (a, b.c_str ()) < 0; }
+    template <size_t N> inline bool __mapLess__ (const Cstring<N>& a, const char *b) { return strcmp (a.c_str (), b) < 0; }
+    template <size_t N, size_t M> inline bool __mapLess__ (const Cstring<N>& a, const Cstring<M>& b) { return strcmp (a.c_str (), b.c_str ()) < 0; }
+    // C strings are compared by their contents, not by their addresses
+    inline bool __mapLess__ (const char *a, const char *b) { return strcmp (a, b) < 0; }
+    inline bool __mapLess__ (char *a, char *b) { return strcmp (a, b) < 0; }
+    inline bool __mapLess__ (const char *a, char *b) { return strcmp (a, b) < 0; }
+    inline bool __mapLess__ (char *a, const char *b) { return strcmp (a, b) < 0; }
+
+    // three-way key comparison used by Map, like strcmp it returns a negative number if a < b, 0 if a == b and a positive number if a > b, so Map needs only one comparison
+    // per node, which halves the number of (String) comparisons, the other key can be of any type comparable to keyType
+    template <class A, class B> inline int __mapCompare__ (const A& a, const B& b) { return a < b ? -1 : (b < a ? 1 : 0); }
+    inline int __mapCompare__ (const String& a, const String& b) { return strcmp (a.c_str (), b.c_str ()); }
+    inline int __mapCompare__ (const String& a, const char *b) { return strcmp (a.c_str (), b); }
+    inline int __mapCompare__ (const char *a, const String& b) { return strcmp (a, b.c_str ()); }
+    inline int __mapCompare__ (const char *a, const char *b) { return strcmp (a, b); }
+    inline int __mapCompare__ (char *a, char *b) { return strcmp (a, b); }
+    inline int __mapCompare__ (const char *a, char *b) { return strcmp (a, b); }
+    inline int __mapCompare__ (char *a, const char *b) { return strcmp (a, b); }
+    template <size_t N, size_t M> inline int __mapCompare__ (const Cstring<N>& a, const Cstring<M>& b) { return strcmp (a.c_str (), b.c_str ()); }
+    template <size_t N> inline int __mapCompare__ (const Cstring<N>& a, const char *b) { return strcmp (a.c_str (), b); }
+    template <size_t N> inline int __mapCompare__ (const char *a, const Cstring<N>& b) { return strcmp (a, b.c_str ()); }
+    template <size_t N> inline int __mapCompare__ (const String& a, const Cstring<N>& b) { return strcmp (a.c_str (), b.c_str ()); }
+    template <size_t N> inline int __mapCompare__ (const Cstring<N>& a, const String& b) { return strcmp (a.c_str (), b.c_str ()); }
+
+
+    /*
+     *  Map's default key comparison policy. A policy is a class with a static compare function that returns a negative number, 0 or a positive number (like strcmp).
+     *  A different policy can be passed to Map as the third template parameter, for example:
+     *
+     *    struct caseInsensitive { static int compare (const char *a, const char *b) { return strcasecmp (a, b); } };
+     *    Map<const char *, int, caseInsensitive> mp;
+     */
+
+    struct map_compare {
+        template <class A, class B> static int compare (const A& a, const B& b) { return __mapCompare__ (a, b); }
+    };
+
+
+    /*
+     *  Balanced (AVL) binary search tree core, shared by Map, set, multiset and multimap. Each container declares its own node type with the members
+     *  leftSubtree, rightSubtree, parent, leftSubtreeHeight, rightSubtreeHeight (and subtreeSize with MAP_ORDER_STATISTICS) followed by what it stores
+     *  (a pair, or just a key), so small keys fit into the padding after the heights. The functions here only relink the nodes and never compare keys,
+     *  the containers find the places of the nodes themselves.
+     */
+
+    template <class nodeType> struct __balancedBinarySearchTree__ {
+
+        // returns the height of (sub)tree with the root in node p, according to the height information stored in p
+        static int8_t __subtreeHeight__ (nodeType *p) { return p ? max (p->leftSubtreeHeight, p->rightSubtreeHeight) + 1 : 0; }
+
+        // subtree sizes are calculated from the sizes of the subtrees of subtrees, so they must be corrected from the bottom up
+        #ifdef MAP_ORDER_STATISTICS
+            static int __subtreeSize__ (nodeType *p) { return p ? p->subtreeSize : 0; }
+            static void __updateSubtreeSize__ (nodeType *p) { p->subtreeSize = 1 + __subtreeSize__ (p->leftSubtree) + __subtreeSize__ (p->rightSubtree); }
+            static void __updateSubtreeSizesUpwards__ (nodeType *p) { for (; p; p = p->parent) __updateSubtreeSize__ (p); }
+        #else
+            static void __updateSubtreeSize__ (nodeType *) {}
+            static void __updateSubtreeSizesUpwards__ (nodeType *) {}
+        #endif
+
+        /* the (sub)tree is unbalanced, left subtree is too high, perform right rotation
+                | = *p                 | = *p
+                Y                      X
+               / \                    / \
+              X   c       =>         a   Y
+             / \                        / \
+            a   b                      b   c
+        */
+        static void __rotateRight__ (nodeType **p) {
+            nodeType *y = *p;
+            nodeType *x = y->leftSubtree;
+            y->leftSubtree = x->rightSubtree;                           // picture: Y.leftSubtree = b
+            if (y->leftSubtree)
+                y->leftSubtree->parent = y;
+            y->leftSubtreeHeight = x->rightSubtreeHeight;               // correct the hight information of (picture) b branch
+            x->rightSubtree = y;                                        // picture: X.rightSubtree = Y
+            x->parent = y->parent;
+            y->parent = x;
+            x->rightSubtreeHeight = __subtreeHeight__ (y);              // the height of Y after rotation
+            __updateSubtreeSize__ (y);
+            __updateSubtreeSize__ (x);
+            *p = x;                                                     // X becomes the new (subtree) root
+        }
+
+        /* the (sub)tree is unbalanced, right subtree is too high, perform left rotation
+                | = *p                 | = *p
+                X                      Y
+               / \                    / \
+              a   Y       =>         X   c
+                 / \                / \
+                b   c              a   b
+        */
+        static void __rotateLeft__ (nodeType **p) {
+            nodeType *x = *p;
+            nodeType *y = x->rightSubtree;
+            x->rightSubtree = y->leftSubtree;                           // picture: X.rightSubtree = b
+            if (x->rightSubtree)
+                x->rightSubtree->parent = x;
+            x->rightSubtreeHeight = y->leftSubtreeHeight;               // correct the hight information of (picture) b branch
+            y->leftSubtree = x;                                         // picture: Y.leftSubtree = X
+            y->parent = x->parent;
+            x->parent = y;
+            y->leftSubtreeHeight = __subtreeHeight__ (x);               // the height of X after rotation
+            __updateSubtreeSize__ (x);
+            __updateSubtreeSize__ (y);
+            *p = y;                                                     // Y becomes the new (subtree) root
+        }
+
+        // corrects the height information of node *p after one of its subtrees has changed and rotates it if it got unbalanced, returns true if the height of (sub)tree has changed
+        static bool __rebalance__ (nodeType **p) {
+            nodeType *n = *p;
+            int8_t oldHeight = __subtreeHeight__ (n); // the height information in n hasn't been corrected yet
+            n->leftSubtreeHeight = __subtreeHeight__ (n->leftSubtree);
+            n->rightSubtreeHeight = __subtreeHeight__ (n->rightSubtree);
+
+            if (n->leftSubtreeHeight - n->rightSubtreeHeight > 1) {
+                if (n->leftSubtree->rightSubtreeHeight > n->leftSubtree->leftSubtreeHeight) // left-right case needs double rotation
+                    __rotateLeft__ (&n->leftSubtree);
+                __rotateRight__ (p);
+            } else if (n->rightSubtreeHeight - n->leftSubtreeHeight > 1) {
+                if (n->rightSubtree->leftSubtreeHeight > n->rightSubtree->rightSubtreeHeight) // right-left case needs double rotation
+                    __rotateRight__ (&n->rightSubtree);
+                __rotateLeft__ (p);
+            }
+            return __subtreeHeight__ (*p) != oldHeight;
+        }
+
+        // the height of perfectly balanced binary search tree with n nodes
+        static int8_t __perfectlyBalancedHeight__ (size_t n) {
+            int8_t h = 0;
+            for (; n; n >>= 1)
+                h ++;
+            return h;
+        }
+
+        // returns the link (pointer in the parent node or the root pointer) that points to node n
+        static nodeType **__linkTo__ (nodeType *n, nodeType **root) {
+            if (n->parent == NULL)
+                return root;
+            return n->parent->leftSubtree == n ? &(n->parent->leftSubtree) : &(n->parent->rightSubtree);
+        }
+
+        // goes from node n up to the root rebalancing the nodes, stops as soon as the height of some subtree doesn't change since the nodes above it are not affected then
+        static void __rebalanceUpwards__ (nodeType *n, nodeType **root) {
+            while (n) {
+                nodeType *parent = n->parent; // remember the parent before n gets rotated
+                if (!__rebalance__ (__linkTo__ (n, root)))
+                    return;
+                n = parent;
+            }
+        }
+
+        static nodeType *__leftmost__ (nodeType *p) {
+            while (p->leftSubtree)
+                p = p->leftSubtree;
+            return p;
+        }
+
+        static nodeType *__rightmost__ (nodeType *p) {
+            while (p->rightSubtree)
+                p = p->rightSubtree;
+            return p;
+        }
+
+        // the next node in the order of keys, following parent links, no key comparisons are needed, NULL if n is the last one
+        static nodeType *__next__ (nodeType *n) {
+            if (n->rightSubtree != NULL)                                // if the node has a right subtree the next node is the leftmost node in the right subtree
+                return __leftmost__ (n->rightSubtree);
+            nodeType *p = n->parent;                                    // else climb up until we come from the left subtree
+            while (p && n == p->rightSubtree) {
+                n = p;
+                p = p->parent;
+            }
+            return p;
+        }
+
+        // the previous node in the order of keys, NULL if n is the first one
+        static nodeType *__previous__ (nodeType *n) {
+            if (n->leftSubtree != NULL)                                 // if the node has a left subtree the previous node is the rightmost node in the left subtree
+                return __rightmost__ (n->leftSubtree);
+            nodeType *p = n->parent;                                    // else climb up until we come from the right subtree
+            while (p && n == p->leftSubtree) {
+                n = p;
+                p = p->parent;
+            }
+            return p;
+        }
+
+        // links a new node n (with no subtrees) to link p below the parent, where the search for its key has ended, returns the new height of the tree
+        static int8_t __link__ (nodeType *n, nodeType *parent, nodeType **p, nodeType **root) {
+            n->parent = parent;
+            *p = n;
+            __updateSubtreeSizesUpwards__ (n);
+            __rebalanceUpwards__ (parent, root);
+            return __subtreeHeight__ (*root);
+        }
+
+        // takes the target node out of the tree without destructing it, returns the new height of the tree
+        static int8_t __unlink__ (nodeType *target, nodeType **root) {
+            nodeType **p = __linkTo__ (target, root);
+
+            nodeType *rebalanceFrom; // the lowest node whose subtree has changed
+            if (target->leftSubtree == NULL || target->rightSubtree == NULL) {
+                // the node has at most one child, replace the node with its child
+                nodeType *child = target->leftSubtree ? target->leftSubtree : target->rightSubtree;
+                if (child)
+                    child->parent = target->parent;
+                *p = child;
+                rebalanceFrom = target->parent;
+            } else {
+                // the node has both children, replace it with its inorder successor (= leftmost node from right subtree), the contents are not copied, just the nodes get relinked
+                nodeType *successor = target->rightSubtree;
+                while (successor->leftSubtree)
+                    successor = successor->leftSubtree;
+                if (successor->parent == target) {
+                    rebalanceFrom = successor;                              // successor keeps its right subtree
+                } else {
+                    rebalanceFrom = successor->parent;
+                    successor->parent->leftSubtree = successor->rightSubtree; // remove successor from its position
+                    if (successor->rightSubtree)
+                        successor->rightSubtree->parent = successor->parent;
+                    successor->rightSubtree = target->rightSubtree;
+                    successor->rightSubtree->parent = successor;
+                }
+                successor->leftSubtree = target->leftSubtree;               // and put it to the position of target node, with its old height information
+                successor->leftSubtree->parent = successor;
+                successor->parent = target->parent;
+                successor->leftSubtreeHeight = target->leftSubtreeHeight;
+                successor->rightSubtreeHeight = target->rightSubtreeHeight;
+                *p = successor;
+            }
+
+            __updateSubtreeSizesUpwards__ (rebalanceFrom);
+            __rebalanceUpwards__ (rebalanceFrom, root);
+            return __subtreeHeight__ (*root);
+        }
+
+        // takes the first node out of the tree without rebalancing, so the nodes can be freed one after another when the whole tree is being cleared, NULL when the tree is empty
+        static nodeType *__takeFirst__ (nodeType **root) {
+            // rotate left subtrees to the right until the node doesn't have a left subtree any more - no recursion or stack is needed
+            nodeType *n = *root;
+            if (n == NULL)
+                return NULL;
+            while (n->leftSubtree) {
+                nodeType *l = n->leftSubtree;
+                n->leftSubtree = l->rightSubtree;
+                l->rightSubtree = n;
+                n = l;
+            }
+            *root = n->rightSubtree;
+            return n;
+        }
+
+        // links a block of n nodes (stride bytes apart), already sorted by their keys, into a perfectly balanced binary search tree
+        static void __linkBalanced__ (nodeType *nodes, size_t stride, size_t n, nodeType **root) {
+            // the middle node of each range becomes the root of its subtree, the nodes on its left and right form its subtrees
+            struct { size_t from, to; nodeType **link; nodeType *parent; } stack [2 * sizeof (size_t) * 8];
+            int8_t sp = 0;
+            stack [sp ++] = { 0, n, root, NULL };
+            while (sp > 0) {
+                auto r = stack [-- sp];
+                size_t middle = r.from + (r.to - r.from) / 2;
+                nodeType *p = (nodeType *) ((char *) nodes + middle * stride);
+                *r.link = p;
+                p->parent = r.parent;
+                p->leftSubtreeHeight = __perfectlyBalancedHeight__ (middle - r.from);
+                p->rightSubtreeHeight = __perfectlyBalancedHeight__ (r.to - middle - 1);
+                #ifdef MAP_ORDER_STATISTICS
+                    p->subtreeSize = r.to - r.from;
+                #endif
+                if (middle > r.from)
+                    stack [sp ++] = { r.from, middle, &p->leftSubtree, p };
+                if (r.to > middle + 1)
+                    stack [sp ++] = { middle + 1, r.to, &p->rightSubtree, p };
+            }
+        }
+
+    };
+
+
+    template <class keyType, class valueType, class keyCompare = map_compare> class Map {
 
         private: 
 
@@ -59,6 +492,9 @@
                 // }                
             };
 
+            class iterator;             // forward declarations, both are defined below
+            struct insert_result;
+
 
            /*
             *  Constructor of Map with no pairs allows the following kinds of creation od Map pairs: 
@@ -94,17 +530,14 @@
                                 return;
                             }
 
-                        __balancedBinarySearchTreeNode__ *pInserted = NULL; 
-                        signed char h = __insert__ (&__root__, i.first, i.second, &pInserted);
-                        if  (h >= 0)  // OK, h contains the balanced binary search tree height 
-                            __height__ = h;
+                        __insert__ (i.first, i.second);
                     }
                 }
           #endif  
           // #else
                 // constructor accepting the array by reference, since AVR boards do not support initializer lists (thanks for this solution to Microsot Copilot)
                 template <int N>
-                Map (const typename Map<keyType, valueType>::Pair (&array) [N]) {
+                Map (const Pair (&array) [N]) {
                     for (int i = 0; i < N; ++i) {
                         
                         if (is_same<keyType, String>::value)     // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
@@ -162,6 +595,13 @@
             signed char height () { return __height__; }
 
 
+           /*
+            *  Returns the number of bytes a pair takes in the node pool (the pair together with the links and heights of its node).
+            */
+
+            static size_t node_size () { return __nodePool_t__::stride (); }
+
+
            /*
             *  Checks if there are no pairs.
             */
@@ -175,6 +615,7 @@
 
             void clear () { 
                 __clear__ (&__root__); 
+                __height__ = 0;
                 clearErrorFlags ();
             } 
 
@@ -190,11 +631,8 @@
             */
       
             Map (Map& other) {
-                // copy other's elements
-                for (auto e: other) {
-                    __balancedBinarySearchTreeNode__ *pInserted = NULL; 
-                    int h = this->__insert__ (&__root__, e.first, e.second, &pInserted); if  (h >= 0) __height__ = h;
-                }
+                // copy other's elements, they are already sorted so the balanced binary search tree can be built directly
+                assign_sorted (other.begin (), other.end ());
                 // copy the error flags as well
                 __errorFlags__ |= other.__errorFlags__;
             }
@@ -210,34 +648,8 @@
             */
       
             Map* operator = (Map other) {
-                this->clear (); // clear existing pairs if needed
-
-                // copy other's pairs
-                for (auto e: other) {
-
-                    if (is_same<keyType, String>::value)     // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
-                        if (!*(String *) &e.first) {                            // ... check if parameter construction is valid
-                            // log_e ("BAD_ALLOC");
-                            #ifdef USE_MAP_EXCEPTIONS
-                                throw err_bad_alloc;
-                            #endif
-                            __errorFlags__ |= err_bad_alloc;          // report error if it is not
-                            return this;
-                        }
-
-                    if (is_same<valueType, String>::value)   // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
-                        if (!*(String *) &e.second) {                          // ... check if parameter construction is valid
-                            // log_e ("BAD_ALLOC");
-                            #ifdef USE_MAP_EXCEPTIONS
-                                throw err_bad_alloc;
-                            #endif
-                            __errorFlags__ |= err_bad_alloc;          // report error if it is not
-                            return this;
-                        }
-
-                    __balancedBinarySearchTreeNode__ *pInserted = NULL; 
-                    int h = this->__insert__ (&__root__, e.first, e.second, &pInserted); if  (h >= 0) __height__ = h;
-                }
+                // copy other's pairs, they are already sorted so the balanced binary search tree can be built directly (this also clears existing pairs)
+                assign_sorted (other.begin (), other.end ());
                 // copy the error flags as well
                 __errorFlags__ |= other.__errorFlags__;
 
@@ -256,12 +668,13 @@
             *  Error handling can be somewhat tricky. It may be a good idea to use USE_MAP_EXCEPTIONS if using [] operator.
             */
 
-            // mp [key] = value version of [] operator
-            valueType &operator [] (keyType key) {
+            // mp [key] = value version of [] operator, key can be of any type comparable to keyType (like const char * for String keys), keyType is constructed only if a new pair is inserted
+            template <class K>
+            valueType &operator [] (const K& key) {
                 static valueType dummyValue1 = {};
                 static valueType dummyValue2 = {};
 
-                if (is_same<keyType, String>::value)      // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                if (is_same<K, String>::value)            // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
                     if (!*(String *) &key) {              // ... check if parameter construction is valid
                         // log_e ("BAD_ALLOC");
                         #ifdef USE_MAP_EXCEPTIONS
@@ -272,35 +685,28 @@
                         return dummyValue1;               // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
                     }
 
-                // find the right pair
-                __balancedBinarySearchTreeNode__ *p = __root__;
-                while (p != NULL) {
-                    if (key < p->pair.first) 
-                        p = p->leftSubtree;           // 1. case: continue searching in left subtree
-                    else if (p->pair.first < key) 
-                        p = p->rightSubtree;          // 2. case: continue searching in reight subtree
-                    else {
-                        return p->pair.second;        // 3. case: found, return the reference ot the value
-                    }
-                }
-                // else                               // 4. case: not found, else insert a new pair
-                __balancedBinarySearchTreeNode__ *pInserted = NULL; 
-                signed char h = __insert__ (&__root__, key, dummyValue2, &pInserted);
-                if  (h >= 0) {  // OK, h contains the balanced binary search tree height 
-                    __height__ = h;
-                    return pInserted->pair.second;
-                }
-                // else there was some other kind of error
+                // find the right pair, the search remembers where a new pair would belong, so the tree is traversed only once
+                __balancedBinarySearchTreeNode__ **link;
+                __balancedBinarySearchTreeNode__ *parent;
+                __balancedBinarySearchTreeNode__ *p = __search__ (key, &link, &parent);
+                if (p != NULL)
+                    return p->pair.second;                // found, return the reference ot the value
+                // else                                   // not found, else insert a new pair
+                p = __emplace__ (link, parent, key);
+                if (p != NULL)
+                    return p->pair.second;
+                // else there was some kind of error
                 dummyValue1 = dummyValue2;
                 return dummyValue1;                         // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
             }
 
             // value = mp [key] version of [] operator (similar as above, but without inserting a key)
-            const valueType &operator [] (keyType key) const {
+            template <class K>
+            const valueType &operator [] (const K& key) const {
                 static valueType dummyValue1 = {};
                 static valueType dummyValue2 = {};
 
-                if (is_same<keyType, String>::value)      // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                if (is_same<K, String>::value)            // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
                     if (!*(String *) &key) {              // ... check if parameter construction is valid
                         // log_e ("BAD_ALLOC");
                         #ifdef USE_MAP_EXCEPTIONS
@@ -312,31 +718,54 @@
                     }
 
                 // find the right pair
-                __balancedBinarySearchTreeNode__ *p = __root__;
-                while (p != NULL) {
-                    if (key < p->pair.first) 
-                        p = p->leftSubtree;           // 1. case: continue searching in left subtree
-                    else if (p->pair.first < key) 
-                        p = p->rightSubtree;          // 2. case: continue searching in reight subtree
-                    else {
-                        return p->pair.second;        // 3. case: found, return the reference ot the value
-                    }
-                }
-                // else                               // 4. case: not found
+                __balancedBinarySearchTreeNode__ *p = __find__ (key);
+                if (p != NULL)
+                    return p->pair.second;            // found, return the reference ot the value
+                // else                               // not found
                 dummyValue1 = dummyValue2;
                 return dummyValue1;                   // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
             }
 
 
+           /*
+            *  Checks if there is a pair with the key. Key can be of any type comparable to keyType.
+            */
+
+            template <class K>
+            bool contains (const K& key) const { return __find__ (key) != NULL; }
+
+
+           /*
+            *  Returns the pointer to the value of the pair with the key or NULL if there is no such pair. Key can be of any type comparable to keyType. Example:
+            *
+            *    int *v = mpB.get_if ("one");
+            *    if (v) 
+            *        Serial.println (*v); 
+            */
+
+            template <class K>
+            valueType *get_if (const K& key) {
+                __balancedBinarySearchTreeNode__ *p = __find__ (key);
+                return p ? &(p->pair.second) : NULL;
+            }
+
+            template <class K>
+            const valueType *get_if (const K& key) const {
+                __balancedBinarySearchTreeNode__ *p = __find__ (key);
+                return p ? &(p->pair.second) : NULL;
+            }
+
+
            /*
             *  Erases the Map pair identified by key
             *  
             *  Returns OK if succeeds and error err_not_found or err_bad_alloc if String key parameter could not be constructed.
             */
 
-            signed char erase (keyType key) { 
+            template <class K>
+            signed char erase (const K& key) { 
 
-                if (is_same<keyType, String>::value)   // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                if (is_same<K, String>::value)         // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
                     if (!*(String *) &key) {                 // ... check if parameter construction is valid
                         // log_e ("BAD_ALLOC");
                         #ifdef USE_MAP_EXCEPTIONS
@@ -357,10 +786,15 @@
 
 
            /*
-            *  Inserts a new Map pair, returns OK or one of the errors.
+            *  Inserts a new Map pair. The result converts to OK or one of the errors (err_not_unique if the key is already there), so it can be checked like an error code,
+            *  but it also holds the iterator to the pair with the key (first) and whether the pair has been inserted (second), so there is no need for another find:
+            *
+            *    auto r = mp.insert (1, "one");
+            *    if (!r.second && r != err_bad_alloc)
+            *        r.first->second = "uno";     // the key was already there
             */
 
-            signed char insert (Pair pair) { 
+            insert_result insert (Pair pair) { 
 
                 if (is_same<keyType, String>::value)   // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
                     if (!*(String *) &pair.first) {                        // ... check if parameter construction is valid
@@ -369,7 +803,7 @@
                             throw err_bad_alloc;
                         #endif
                         __errorFlags__ |= err_bad_alloc;        // report error if it is not
-                        return err_bad_alloc;                   // report error if it is not
+                        return { end (), false, err_bad_alloc }; // report error if it is not
                     }
 
                 if (is_same<valueType, String>::value) // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
@@ -379,19 +813,13 @@
                             throw err_bad_alloc;
                         #endif
                         __errorFlags__ |= err_bad_alloc;        // report error if it is not
-                        return err_bad_alloc;                   // report error if it is not
+                        return { end (), false, err_bad_alloc }; // report error if it is not
                     }
 
-                __balancedBinarySearchTreeNode__ *pInserted = NULL; 
-                int h = __insert__ (&__root__, pair.first, pair.second, &pInserted);                 
-                if  (h >= 0) {  // OK, h contains the balanced binary search tree height 
-                    __height__ = h;
-                    return err_ok;
-                } else
-                    return h;
+                return __insert__ (pair.first, pair.second);
             }
 
-            signed char insert (keyType key, valueType value) { 
+            insert_result insert (keyType key, valueType value) { 
 
                 if (is_same<keyType, String>::value)   // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
                     if (!*(String *) &key) {                             // ... check if parameter construction is valid
@@ -400,7 +828,7 @@
                             throw err_bad_alloc;
                         #endif
                         __errorFlags__ |= err_bad_alloc;        // report error if it is not
-                        return err_bad_alloc;                   // report error if it is not
+                        return { end (), false, err_bad_alloc }; // report error if it is not
                     }
 
                 if (is_same<valueType, String>::value) // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
@@ -410,19 +838,206 @@
                             throw err_bad_alloc;
                         #endif
                         __errorFlags__ |= err_bad_alloc;        // report error if it is not
-                        return err_bad_alloc;                   // report error if it is not
+                        return { end (), false, err_bad_alloc }; // report error if it is not
                     }
 
-                __balancedBinarySearchTreeNode__ *pInserted = NULL;
-                int h = __insert__ (&__root__, key, value, &pInserted);
-                if  (h >= 0) {  // OK, h contains the balanced binary search tree height
-                    __height__ = h;
-                    return err_ok;
-                } else
-                    return h;
+                return __insert__ (key, value);
+            }
+
+
+           /*
+            *  try_emplace inserts a new pair only if the key is not there yet, the value is constructed from args directly in the new node and keyType is constructed
+            *  from the key only then. If the key is already there nothing changes and this is not an error. insert_or_assign inserts a new pair or assigns the value
+            *  to the existing one. Both search the tree only once. Example:
+            *
+            *    counters.try_emplace ("rx", 0);
+            *    auto r = counters.insert_or_assign ("tx", 42);
+            *    if (r.second)
+            *        Serial.println ("tx is a new counter");
+            */
+
+            template <class K, class... Args>
+            insert_result try_emplace (const K& key, Args&&... args) {
+
+                if (is_same<K, String>::value)            // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;  // report error if it is not
+                        return { end (), false, err_bad_alloc };
+                    }
+
+                __balancedBinarySearchTreeNode__ **link;
+                __balancedBinarySearchTreeNode__ *parent;
+                __balancedBinarySearchTreeNode__ *p = __search__ (key, &link, &parent);
+                if (p != NULL)
+                    return { iterator (p, this), false, err_ok };   // the key is already there
+                p = __emplace__ (link, parent, key, static_cast<Args&&> (args)...);
+                if (p == NULL)
+                    return { end (), false, err_bad_alloc };
+                return { iterator (p, this), true, err_ok };
+            }
+
+            template <class K>
+            insert_result insert_or_assign (const K& key, valueType value) {
+
+                if (is_same<K, String>::value)            // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;  // report error if it is not
+                        return { end (), false, err_bad_alloc };
+                    }
+
+                if (is_same<valueType, String>::value)    // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &value) {            // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;  // report error if it is not
+                        return { end (), false, err_bad_alloc };
+                    }
+
+                __balancedBinarySearchTreeNode__ **link;
+                __balancedBinarySearchTreeNode__ *parent;
+                __balancedBinarySearchTreeNode__ *p = __search__ (key, &link, &parent);
+                if (p != NULL) {
+                    p->pair.second = value;
+                    // in case of Strings - it is possible that the value didn't get copied, so just swap stack memory with the parameter - this always succeeds
+                    if (is_same<valueType, String>::value)
+                        if (!*(String *) &p->pair.second)
+                            __swapStrings__ ((String *) &p->pair.second, (String *) &value);
+                    return { iterator (p, this), false, err_ok };
+                }
+                p = __emplace__ (link, parent, key, value);
+                if (p == NULL)
+                    return { end (), false, err_bad_alloc };
+                return { iterator (p, this), true, err_ok };
             }
     
         
+           /*
+            *  Replaces the pairs of Map with the pairs from [first, last) range. If the pairs are sorted by their keys (and the keys are unique), like when they
+            *  come from another Map or from a sorted table, a perfectly balanced binary search tree is built directly in O (n) time, with all the nodes allocated
+            *  in one block. Otherwise the pairs are inserted one by one. Returns OK or one of the errors. Example:
+            *
+            *    Map<int, String>::Pair table [] = { {1, "one"}, {2, "two"}, {3, "three"} };
+            *    mp.assign_sorted (table, table + 3);
+            */
+
+            template <class iteratorType>
+            signed char assign_sorted (iteratorType first, iteratorType last) {
+                clear ();
+
+                // count the pairs and check if they are sorted
+                size_t n = 0;
+                bool sorted = true;
+                for (iteratorType it = first, previous = first; it != last; previous = it, ++ it)
+                    if (n ++ > 0 && keyCompare::compare ((*previous).first, (*it).first) >= 0)
+                        sorted = false;
+                if (n == 0)
+                    return err_ok;
+
+                __balancedBinarySearchTreeNode__ *nodes = NULL;
+                if (sorted)
+                    nodes = (__balancedBinarySearchTreeNode__ *) __nodePool__ ().allocate (n);
+                if (nodes == NULL) { // the pairs are not sorted or there is no contiguous block of memory large enough, insert them one by one
+                    signed char e = err_ok;
+                    for (iteratorType it = first; it != last; ++ it) {
+                        signed char r = insert ((*it).first, (*it).second);
+                        if (r != err_ok)
+                            e = r;
+                    }
+                    return e;
+                }
+                size_t stride = __nodePool_t__::stride ();
+
+                // construct the nodes in the order of keys
+                size_t i = 0;
+                for (iteratorType it = first; it != last; ++ it, i ++) {
+                    __balancedBinarySearchTreeNode__ *p = (__balancedBinarySearchTreeNode__ *) ((char *) nodes + i * stride);
+                    memset (p, 0, sizeof (__balancedBinarySearchTreeNode__));
+                    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                        new (&p->pair) Pair { (*it).first, (*it).second };
+                    #else
+                        p->pair.first = (*it).first;
+                        p->pair.second = (*it).second;
+                    #endif
+
+                    // in case of Strings - it is possible that key and value didn't get constructed
+                    if ((is_same<keyType, String>::value && !*(String *) &p->pair.first) || (is_same<valueType, String>::value && !*(String *) &p->pair.second)) {
+                        __freeNodes__ (nodes, i + 1, n);
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+                }
+
+                __linkBalanced__ (nodes, n);
+                return err_ok;
+            }
+
+
+           /*
+            *  Saves the pairs into a binary snapshot, stream can be File, any other Arduino Stream or FILE *. The pairs are written in the order of keys,
+            *  so load can build the balanced binary search tree directly. Returns OK or err_bad_data if the stream couldn't be written (or a String is longer
+            *  than 65535 characters). Keys and values must not point to other memory (C strings, structures with String members, ...). Example:
+            *
+            *    File f = LittleFS.open ("/config.bin", "w");
+            *    config.save (f);
+            *    f.close ();
+            */
+
+            template <class streamType>
+            signed char save (streamType& stream) {
+                __snapshotStream__<streamType> s (stream);
+                bool ok = s.writeHeader (__size__, sizeof (keyType), sizeof (valueType));
+                for (auto it = begin (); ok && it != end (); ++ it)
+                    ok = s.writeValue (it->first) && s.writeValue (it->second);
+                if (ok && s.writeChecksum ())
+                    return err_ok;
+                #ifdef USE_MAP_EXCEPTIONS
+                    throw err_bad_data;
+                #endif
+                __errorFlags__ |= err_bad_data;
+                return err_bad_data;
+            }
+
+
+           /*
+            *  Replaces the pairs with the pairs from a binary snapshot made by save. The nodes are allocated in one block, the pairs are read directly into them
+            *  and the perfectly balanced binary search tree is linked in O (n) time. Returns OK, err_bad_alloc or err_bad_data if the snapshot is incomplete,
+            *  corrupted (checksum) or made by a different kind of Map. Example:
+            *
+            *    File f = LittleFS.open ("/config.bin", "r");
+            *    if (config.load (f) != err_ok)
+            *        parseConfigurationText ();  // fall back to the slow way
+            *    f.close ();
+            */
+
+            template <class streamType>
+            signed char load (streamType& stream) {
+                clear ();
+                __snapshotStream__<streamType> s (stream);
+                signed char e = __load__ (s);
+                if (e != err_ok) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw e;
+                    #endif
+                    __errorFlags__ |= e;
+                }
+                return e;
+            }
+
+
            /*
             *   Iterator
             *   
@@ -445,144 +1060,54 @@
                 iterator (Map* mp, bool pointToFirstPair) {
                     __mp__ = mp;
 
-                    if (!pointToFirstPair || __mp__->size () == 0) // when end () is beeing called, stack for balanced binary search tree iteration is not needed (yet)
+                    if (!pointToFirstPair || __mp__->size () == 0) // end () doesn't point to any node
                         return;
-                    // else find the lowest pair in the balanced binary search tree (this would be the leftmost one) and fill the stack meanwhile
+                    // else find the lowest pair in the balanced binary search tree (this would be the leftmost one)
 
-                    Map::__balancedBinarySearchTreeNode__* p = mp->__root__;
-                    while (p) {
-                        __stack__ [++ __stackPointer__] = p;                      
-                        p = p->leftSubtree;
-                    }
-                    __lastVisitedPair__ = __stack__ [__stackPointer__]; // remember the last visited pair
+                    __node__ = __tree__::__leftmost__ (mp->__root__);
                 }
 
-                // find the key, construct the stack meanwhile
-                iterator (keyType key, Map* mp) {
+                // the iterator pointing to a node that has already been found
+                iterator (Map::__balancedBinarySearchTreeNode__ *node, Map* mp) {
                     __mp__ = mp;
-
-                    if (__mp__->size () == 0)
-                        return;
-                    // else
-
-                    Map::__balancedBinarySearchTreeNode__* p = mp->__root__;
-                    while (p) {
-                        __stack__ [++ __stackPointer__] = p;            
-
-                        if (key < p->pair.first) 
-                            p = p->leftSubtree;                                 // 1. case: continue searching in left subtree
-                        else if (p->pair.first < key) 
-                            p = p->rightSubtree;                                // 2. case: continue searching in reight subtree
-                        else {
-                            __lastVisitedPair__ = __stack__ [__stackPointer__]; // 3. case: found, return the reference ot the value,  remember the last visited pair
-                            return;
-                        }
-                    }
-
-                    __stackPointer__ = -1;                                      // 4. case: not found
-                    __lastVisitedPair__ = NULL;
+                    __node__ = node;
                 }
 
 
                 // * operator
-                Pair& operator *() { return (__lastVisitedPair__->pair); }
+                Pair& operator *() { return (__node__->pair); }
 
                 // -> operator
-                Pair * operator -> () { return &(__lastVisitedPair__->pair); }
+                Pair * operator -> () { return &(__node__->pair); }
 
-                // ++ (prefix) increment actually moves the state of the stack so that the last element points to the next balanced binary search tree node
+                // ++ (prefix) increment moves to the next balanced binary search tree node, following parent links, no key comparisons are needed
                 iterator& operator ++ () { 
-
-                    // the current node is pointed to by stack pointer, move to the next node
-
-                    // if the node has a right subtree find the leftmost element in the right subtree and fill the stack meanwhile
-                    if (__stack__ [__stackPointer__]->rightSubtree != NULL) {
-                        Map::__balancedBinarySearchTreeNode__* p = __stack__ [__stackPointer__]->rightSubtree;
-                        if (p && p != __stack__ [__stackPointer__ + 1]) { // if the right subtree has not ben visited yet, proceed with the right subtree
-                            while (p) {
-                                __stack__ [++ __stackPointer__] = p;
-                                p = p->leftSubtree;
-                            }
-                            __lastVisitedPair__ = __stack__ [__stackPointer__]; // remember the last visited pair
-                            return *this;
-                        }
-                    }
-                    // else proceed with climbing up the stack to the first pair that is greater than the current node
-                    {
-                        int8_t i = __stackPointer__;
-                        if (-- __stackPointer__ >= 0)
-                            while (__stackPointer__ >= 0 && __stack__ [__stackPointer__]->pair.first < __stack__ [i]->pair.first) 
-                                __stackPointer__ --;
-
-                        if (__stackPointer__ >= 0)
-                          __lastVisitedPair__ = __stack__ [__stackPointer__]; // remember the last visited pair
-                        else
-                            __lastVisitedPair__ = NULL;
-
-                        return *this;
-                    }
+                    __node__ = __tree__::__next__ (__node__);                   // NULL if there are no more nodes, which is end ()
+                    return *this;
                 }  
 
-                // -- (prefix) increment actually moves the state of the stack so that the last element points to the previous balanced binary search tree node
+                // -- (prefix) decrement moves to the previous balanced binary search tree node
                 iterator& operator -- () { 
-                    if (__lastVisitedPair__ == NULL) { // we came here with -- end (), so the stack is not constructed yet, start with the last (rightmost) element
-                        if (__mp__->size () == 0) return *this;
-        
-                        // find the highest pair in the balanced binary search tree (this would be the righttmost one) and fill the stack meanwhile
-                        Map::__balancedBinarySearchTreeNode__* p = __mp__->__root__;
-                        while (p) {
-                            __stack__ [++ __stackPointer__] = p;                      
-                            p = p->rightSubtree;
-                        }
-                        __lastVisitedPair__ = __stack__ [__stackPointer__]; // remember the last visited pair
-                        return *this;
-                    }
-
-                    // the current node is pointed to by stack pointer, move to the previous node
-
-                    // if the node has a left subtree find the rightmost element in the left subtree and fill the stack meanwhile
-                    if (__stack__ [__stackPointer__]->leftSubtree != NULL) {
-                        Map::__balancedBinarySearchTreeNode__* p = __stack__ [__stackPointer__]->leftSubtree;
-                        if (p && p != __stack__ [__stackPointer__ + 1]) { // if the left subtree has not ben visited yet, proceed with the left subtree
-                            while (p) {
-                                __stack__ [++ __stackPointer__] = p;
-                                p = p->rightSubtree;
-                            }
-                            __lastVisitedPair__ = __stack__ [__stackPointer__]; // remember the last visited pair
-                            return *this; 
-                        }
-                    }
-                    // else proceed with climbing up the stack to the first pair that is lesser than the current node
-                    {
-                        int8_t i = __stackPointer__;
-                        if (-- __stackPointer__ >= 0)
-                            while (__stackPointer__ >= 0 && __stack__ [__stackPointer__]->pair.first > __stack__ [i]->pair.first) 
-                                __stackPointer__ --;
-
-                        if (__stackPointer__ >= 0)
-                          __lastVisitedPair__ = __stack__ [__stackPointer__]; // remember the last visited pair
-                        else
-                            __lastVisitedPair__ = NULL;
-
-                        return *this;
+                    if (__node__ == NULL) {                                     // we came here with -- end (), start with the last (rightmost) element
+                        if (__mp__->__root__ != NULL)
+                            __node__ = __tree__::__rightmost__ (__mp__->__root__);
+                    } else {
+                        __node__ = __tree__::__previous__ (__node__);
                     }
+                    return *this;
                 }
 
-                // C++ will stop iterating when != operator returns false, this is when all nodes have been visited and stack pointer is negative
-                friend bool operator != (const iterator& a, const iterator& b) { return a.__lastVisitedPair__ != b.__lastVisitedPair__; }
-                friend bool operator == (const iterator& a, const iterator& b) { return a.__lastVisitedPair__ == b.__lastVisitedPair__; }
+                // C++ will stop iterating when != operator returns false, this is when all nodes have been visited
+                friend bool operator != (const iterator& a, const iterator& b) { return a.__node__ != b.__node__; }
+                friend bool operator == (const iterator& a, const iterator& b) { return a.__node__ == b.__node__; }
 
                 // this will tell if iterator is valid (if there are not elements the iterator can not be valid)
                 operator bool () const { return __mp__->size () > 0; }
             
             private:
             
-                Map* __mp__ = NULL;
-
-                // a stack is needed to iterate through binary balanced search tree nodes
-                Map::__balancedBinarySearchTreeNode__ *__stack__ [__MAP_MAX_STACK_SIZE__] = {};
-                int8_t __stackPointer__ = -1;
-                Map::__balancedBinarySearchTreeNode__ *__lastVisitedPair__ = NULL;
+                Map* __mp__ = NULL;                                             // needed for -- end () only
+                Map::__balancedBinarySearchTreeNode__ *__node__ = NULL;         // NULL means end ()
 
             };      
   
@@ -590,6 +1115,20 @@
             iterator end ()   { return iterator (this, false); }
 
 
+           /*
+            *  The result of insert, try_emplace and insert_or_assign, like std::pair<iterator, bool> with the error code.
+            */
+
+            struct insert_result {
+                iterator first;             // the pair with the key, end () if there was an error
+                bool second;                // true if a new pair has been inserted
+                signed char error;          // OK or one of the errors
+
+                // so the result can still be checked like insert's error code
+                operator signed char () const { return error; }
+            };
+
+
            /*
             *  Returns an iterator to the pair with the key, if key is found, end () if it is not. Example:
             *  
@@ -600,9 +1139,10 @@
             *        Serial.println ("not found");
             */
             
-            iterator find (keyType key) {
+            template <class K>
+            iterator find (const K& key) {
 
-                if (is_same<keyType, String>::value)      // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                if (is_same<K, String>::value)            // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
                     if (!*(String *) &key) {              // ... check if parameter construction is valid
                         // log_e ("BAD_ALLOC");
                         #ifdef USE_MAP_EXCEPTIONS
@@ -612,9 +1152,122 @@
                         return end ();
                     }
 
-                return iterator (key, this);
+                return iterator (__find__ (key), this);
+            }
+
+           /*
+            *  lower_bound returns an iterator to the first pair with the key not less than the given key, upper_bound returns an iterator to the first pair
+            *  with the key greater than the given key, end () if there is no such pair. They take O (log n) time, so scanning a range of k pairs takes O (log n + k). Example:
+            *  
+            *    // all the readings between t1 and t2
+            *    auto last = readings.upper_bound (t2);
+            *    for (auto it = readings.lower_bound (t1); it != last; ++ it)
+            *        Serial.println (it->second); 
+            */
+
+            template <class K>
+            iterator lower_bound (const K& probe) {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __balancedBinarySearchTreeNode__ *p = __root__;
+                __balancedBinarySearchTreeNode__ *bound = NULL;
+                while (p) {
+                    if (keyCompare::compare (p->pair.first, key) < 0) {
+                        p = p->rightSubtree;                // the bound is in the right subtree
+                    } else {
+                        bound = p;                          // p is a candidate, but there may be a lower one in the left subtree
+                        p = p->leftSubtree;
+                    }
+                }
+                return iterator (bound, this);
+            }
+
+            template <class K>
+            iterator upper_bound (const K& probe) {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __balancedBinarySearchTreeNode__ *p = __root__;
+                __balancedBinarySearchTreeNode__ *bound = NULL;
+                while (p) {
+                    if (keyCompare::compare (key, p->pair.first) < 0) {
+                        bound = p;                          // p is a candidate, but there may be a lower one in the left subtree
+                        p = p->leftSubtree;
+                    } else {
+                        p = p->rightSubtree;                // the bound is in the right subtree
+                    }
+                }
+                return iterator (bound, this);
             }
 
+
+          #ifdef MAP_ORDER_STATISTICS
+               /*
+                *  Order statistics, all in O (log n) time:
+                *
+                *    rank (key) returns the number of pairs with the keys less than key (the position where the key is or would be)
+                *    select (k) and nth (k) return an iterator to the pair with k-th smallest key (counting from 0), end () if k is out of range
+                *
+                *  Example - the median and 90th percentile:
+                *
+                *    auto median = readings.nth (readings.size () / 2);
+                *    auto p90 = readings.nth (readings.size () * 9 / 10);
+                */
+
+                template <class K>
+                int rank (const K& probe) const {
+                    const auto& key = __mapProbe__<keyType, K>::key (probe);
+                    int r = 0;
+                    __balancedBinarySearchTreeNode__ *p = __root__;
+                    while (p) {
+                        if (keyCompare::compare (p->pair.first, key) < 0) {
+                            r += __tree__::__subtreeSize__ (p->leftSubtree) + 1;  // p and its left subtree are all less than key
+                            p = p->rightSubtree;
+                        } else {
+                            p = p->leftSubtree;
+                        }
+                    }
+                    return r;
+                }
+
+                iterator select (int k) {
+                    if (k < 0)
+                        return end ();
+                    __balancedBinarySearchTreeNode__ *p = __root__;
+                    while (p) {
+                        int l = __tree__::__subtreeSize__ (p->leftSubtree);
+                        if (k < l) {
+                            p = p->leftSubtree;                         // k-th node is in the left subtree
+                        } else if (k == l) {
+                            break;                                      // found
+                        } else {
+                            k -= l + 1;                                 // skip the left subtree and p
+                            p = p->rightSubtree;
+                        }
+                    }
+                    return iterator (p, this);
+                }
+
+                iterator nth (int k) { return select (k); }
+          #endif
+
+
+           /*
+            *  A range of pairs [first, second) that can be iterated through like:
+            *
+            *    for (auto& pair: mp.equal_range (key))
+            *        Serial.println (pair.second);
+            */
+
+            struct range {
+                iterator first;
+                iterator second;
+
+                iterator begin () { return first; }
+                iterator end () { return second; }
+            };
+
+            // returns the range of the pairs with the key (which has at most one pair since Map keys are unique)
+            template <class K>
+            range equal_range (const K& key) { return { lower_bound (key), upper_bound (key) }; }
+
             #ifdef __OSTREAM_HPP__
                 // print map to ostream
                 friend ostream& operator << (ostream& os, Map& m) {
@@ -634,17 +1287,37 @@
             // balanced binary search tree for keys
             
             struct __balancedBinarySearchTreeNode__ {
-                Pair pair;
                 __balancedBinarySearchTreeNode__ *leftSubtree;
                 __balancedBinarySearchTreeNode__ *rightSubtree;
+                __balancedBinarySearchTreeNode__ *parent;       // parent links enable iterating without a stack
                 int8_t leftSubtreeHeight;
                 int8_t rightSubtreeHeight;
+                #ifdef MAP_ORDER_STATISTICS
+                    int subtreeSize;                            // the number of nodes in the subtree with the root in this node
+                #endif
+                Pair pair;
             };
+
+            typedef __balancedBinarySearchTree__<__balancedBinarySearchTreeNode__> __tree__;
     
             __balancedBinarySearchTreeNode__ *__root__ = NULL; 
             int __size__ = 0;
             int8_t __height__ = 0;
 
+            // node memory comes from the pool
+            typedef __mapNodePool__<sizeof (__balancedBinarySearchTreeNode__)> __nodePool_t__;
+            #ifdef MAP_SHARED_NODE_POOL
+                __nodePool_t__& __nodePool__ () { return __nodePool_t__::shared (); }
+            #else
+                __nodePool_t__ __ownNodePool__;
+                __nodePool_t__& __nodePool__ () { return __ownNodePool__; }
+            #endif
+
+            void __freeNode__ (__balancedBinarySearchTreeNode__ *n) {
+                n->~__balancedBinarySearchTreeNode__ ();
+                __nodePool__ ().deallocate (n);
+            }
+
             // we need 2 values to handle err_not_found conditions with [] operator
             valueType __dummyValue1__ = {};            
             valueType __dummyValue2__ = {};          
@@ -655,144 +1328,194 @@
 
             // internal functions
             
-            signed char __insert__ (__balancedBinarySearchTreeNode__ **p, keyType& key, valueType& value, __balancedBinarySearchTreeNode__ **pInserted) { // returns the height of balanced binary search tree or error
-                // 1. case: a leaf has been reached - add new node here
-                if ((*p) == NULL) {
-                          
-                    // different ways of allocation the memory for a new node
-                    #if MAP_MEMORY_TYPE == PSRAM_MEM
-                        __balancedBinarySearchTreeNode__ *n = (__balancedBinarySearchTreeNode__ *) ps_malloc (sizeof (__balancedBinarySearchTreeNode__));
-                    #else
-                        __balancedBinarySearchTreeNode__ *n = (__balancedBinarySearchTreeNode__ *) malloc (sizeof (__balancedBinarySearchTreeNode__));
-                    #endif
+            // nodes is a block of n nodes allocated at once, the first constructed of them hold pairs, the rest are returned to the pool without destructing
+            void __freeNodes__ (__balancedBinarySearchTreeNode__ *nodes, size_t constructed, size_t n) {
+                size_t stride = __nodePool_t__::stride ();
+                for (size_t j = 0; j < constructed; j ++)
+                    __freeNode__ ((__balancedBinarySearchTreeNode__ *) ((char *) nodes + j * stride));
+                for (size_t j = constructed; j < n; j ++)
+                    __nodePool__ ().deallocate ((char *) nodes + j * stride);
+            }
 
-                    if (n == NULL) {
-                        #ifdef USE_MAP_EXCEPTIONS
-                            throw err_bad_alloc;
-                        #endif
-                        __errorFlags__ |= err_bad_alloc;
-                        return err_bad_alloc;
-                    }
+            // links a block of n nodes, already sorted by their keys, into a perfectly balanced binary search tree
+            void __linkBalanced__ (__balancedBinarySearchTreeNode__ *nodes, size_t n) {
+                __tree__::__linkBalanced__ (nodes, __nodePool_t__::stride (), n, &__root__);
+                __size__ = n;
+                __height__ = __tree__::__perfectlyBalancedHeight__ (n);
+            }
 
-                    memset (n, 0, sizeof (__balancedBinarySearchTreeNode__));
+            // reads the snapshot into an empty Map, returns OK or one of the errors
+            template <class streamType>
+            signed char __load__ (__snapshotStream__<streamType>& s) {
+                uint32_t n;
+                if (!s.readHeader (&n, sizeof (keyType), sizeof (valueType)))
+                    return err_bad_data;
+                if (n == 0)
+                    return s.checkChecksum () ? err_ok : err_bad_data;
+                if (n > (size_t) -1 / __nodePool_t__::stride ())
+                    return err_bad_data;                            // corrupted count
+                __balancedBinarySearchTreeNode__ *nodes = (__balancedBinarySearchTreeNode__ *) __nodePool__ ().allocate (n);
+                if (nodes == NULL)
+                    return err_bad_alloc;
+                size_t stride = __nodePool_t__::stride ();
+
+                // read the pairs directly into the nodes, in the order of keys
+                for (size_t i = 0; i < n; i ++) {
+                    __balancedBinarySearchTreeNode__ *p = (__balancedBinarySearchTreeNode__ *) ((char *) nodes + i * stride);
+                    memset (p, 0, sizeof (__balancedBinarySearchTreeNode__));
                     #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
-                        new (n) __balancedBinarySearchTreeNode__; 
+                        new (&p->pair) Pair {};
                     #endif
+                    signed char e = s.readValue (p->pair.first);
+                    if (e == err_ok)
+                        e = s.readValue (p->pair.second);
+                    if (e == err_ok && i > 0 && keyCompare::compare (((__balancedBinarySearchTreeNode__ *) ((char *) p - stride))->pair.first, p->pair.first) >= 0)
+                        e = err_bad_data;                           // the keys must be sorted and unique
+                    if (e != err_ok) {
+                        __freeNodes__ (nodes, i + 1, n);
+                        return e;
+                    }
+                }
+                if (!s.checkChecksum ()) {
+                    __freeNodes__ (nodes, n, n);
+                    return err_bad_data;
+                }
+                __linkBalanced__ (nodes, n);
+                return err_ok;
+            }
 
-                    *n = { {key, value}, NULL, NULL, 0, 0 };
-                    *pInserted = n;
+            // returns the node with the key or NULL if it is not found
+            template <class K>
+            __balancedBinarySearchTreeNode__ *__find__ (const K& probe) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __balancedBinarySearchTreeNode__ *p = __root__;
+                while (p) {
+                    int c = keyCompare::compare (key, p->pair.first);      // only one comparison per node
+                    if (c < 0) 
+                        p = p->leftSubtree;                                 // 1. case: continue searching in left subtree
+                    else if (c > 0) 
+                        p = p->rightSubtree;                                // 2. case: continue searching in reight subtree
+                    else 
+                        return p;                                           // 3. case: found
+                }
+                return NULL;                                                // 4. case: not found
+            }
 
-                        // in case of Strings - it is possible that key and value didn't get constructed, so just swap stack memory with parameters - this always succeeds
-                        if (is_same<keyType, String>::value)   // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
-                            if (!*(String *) &n->pair.first)                       // ... check if parameter construction is valid
-                                __swapStrings__ ((String *) &n->pair.first, (String *) &key); 
-                        if (is_same<valueType, String>::value) // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
-                            if (!*(String *) &n->pair.second)                     // ... check if parameter construction is valid
-                                __swapStrings__ ((String *) &n->pair.second, (String *) &value);
+            // insert and erase don't need recursion, they go back up the tree following the parent links
+
+            // searches the tree only once: returns the node with the key, or NULL and the link (and its parent) where the node with the key belongs
+            template <class K>
+            __balancedBinarySearchTreeNode__ *__search__ (const K& probe, __balancedBinarySearchTreeNode__ ***link, __balancedBinarySearchTreeNode__ **parent) {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __balancedBinarySearchTreeNode__ **p = &__root__;
+                *link = NULL;                           // set even if the key is found, so that the callers never see it uninitialized
+                *parent = NULL;
+                while (*p != NULL) {
+                    int c = keyCompare::compare (key, (*p)->pair.first);
+                    if (c < 0) {
+                        *parent = *p;
+                        p = &((*p)->leftSubtree);       // continue searching in left subtree
+                    } else if (c > 0) {
+                        *parent = *p;
+                        p = &((*p)->rightSubtree);      // continue searching in right subtree
+                    } else {
+                        return *p;                      // found
+                    }
+                }
+                *link = p;
+                return NULL;                            // not found
+            }
 
-                    *p = n;
-                    __size__ ++;
-                    return 1; // height of the (sub)tree so far
+            // constructs the pair from the key and args directly in a new node and links the node where __search__ has ended, returns NULL if there is not enough memory
+            template <class K, class... Args>
+            __balancedBinarySearchTreeNode__ *__emplace__ (__balancedBinarySearchTreeNode__ **link, __balancedBinarySearchTreeNode__ *parent, const K& key, Args&&... args) {
+                // get the memory for a new node from the pool
+                __balancedBinarySearchTreeNode__ *n = (__balancedBinarySearchTreeNode__ *) __nodePool__ ().allocate ();
+                if (n == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return NULL;
                 }
-                
-                // 2. case: add a new node to the left subtree of the current node
-                if (key < (*p)->pair.first) {
-                    // log_i ("add a new node to the left subtree");
-
-                    int h = __insert__ (&((*p)->leftSubtree), key, value, pInserted);
-                    if (h < 0) return h; // < 0 means an error
-                    (*p)->leftSubtreeHeight = h;
-                    if ((*p)->leftSubtreeHeight - (*p)->rightSubtreeHeight > 1) {
-                        /* the tree is unbalanced, left subtree is too high, perform right rotation
-                                | = *p                 | = *p
-                                Y                      X
-                                / \                    / \
-                              X   c       =>         a   Y
-                              / \                        / \
-                            a   b                      b   c
-                        */
-                        __balancedBinarySearchTreeNode__ *tmp = (*p)->leftSubtree;  // picture: tmp = X
-                        (*p)->leftSubtree = tmp->rightSubtree;                      // picture: Y.leftSubtree = b
-                        if (tmp->leftSubtree == NULL) { // the rightSubtree can not be NULL at this point otherwise tmp wouldn't be unbalanced
-                            /* handle trivial case that happens at the leaves level and could preserve unbalance even after rotation
-                                    | = tmp                | = tmp
-                                    C                      C
-                                    /                      /
-                                  A           =>         B 
-                                    \                    / 
-                                    B                  A                           
-                            */
-                            tmp->rightSubtree->leftSubtree = tmp; 
-                            tmp = tmp->rightSubtree;
-                            tmp->leftSubtree->rightSubtree = NULL;
-                            tmp->leftSubtree->rightSubtreeHeight = 0;
-                            tmp->leftSubtreeHeight = 1;                
-                        }
-                        (*p)->leftSubtree = tmp->rightSubtree;
-                        (*p)->leftSubtreeHeight = tmp->rightSubtreeHeight;          // correct the hight information of (picture) b branch
-                        tmp->rightSubtree = (*p);                                   // picture: X.rightSubtree = Y
-                        (*p) = tmp;                                                 // X becomes the new (subtree) root
-                        // correct the height information of right subtree - we know that right subtree exists (picture: Y node)
-                        (*p)->rightSubtreeHeight = max ((*p)->rightSubtree->leftSubtreeHeight, (*p)->rightSubtree->rightSubtreeHeight) + 1; // the height of (sub)tree after rotation
-                    } 
-                    return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1; // the new height of (sub)tree
-                }             
-    
-                // 3. case: the node with the same values already exists 
-                if (!((*p)->pair.first < key)) { // meaning at this point that key == (*p)->pair.first
+
+                memset (n, 0, sizeof (__balancedBinarySearchTreeNode__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->pair) Pair { keyType (key), valueType (static_cast<Args&&> (args)...) };
+                #else
+                    n->pair.first = key;
+                    n->pair.second = valueType (static_cast<Args&&> (args)...);
+                #endif
+
+                // in case of Strings - it is possible that key and value didn't get constructed
+                if ((is_same<keyType, String>::value && !*(String *) &n->pair.first) || (is_same<valueType, String>::value && !*(String *) &n->pair.second)) {
+                    __freeNode__ (n);
+                    // log_e ("BAD_ALLOC");
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return NULL;
+                }
+
+                __size__ ++;
+                __height__ = __tree__::__link__ (n, parent, link, &__root__);
+                return n;
+            }
+
+            // inserts a new pair if the key is not there yet, key and value must be valid, in case of Strings they may get swapped with the copies in the node
+            insert_result __insert__ (keyType& key, valueType& value) {
+                __balancedBinarySearchTreeNode__ **link;
+                __balancedBinarySearchTreeNode__ *parent;
+                __balancedBinarySearchTreeNode__ *p = __search__ (key, &link, &parent);
+                if (p != NULL) {                        // the node with the same key already exists
                     // log_e ("NOT_UNIQUE");
                     #ifdef USE_MAP_EXCEPTIONS
                         throw err_not_unique;
                     #endif
                     __errorFlags__ |= err_not_unique;
-                    return err_not_unique;
+                    return { iterator (p, this), false, err_not_unique };
                 }
-        
-                // 4. case: add a new node to the right subtree of the current node
-                // log_i ("add a new node to the right subtree");
-
-                int h = __insert__ (&((*p)->rightSubtree), key, value, pInserted);
-                if (h < 0) return h; // < 0 means an error
-                (*p)->rightSubtreeHeight = h;
-                if ((*p)->rightSubtreeHeight - (*p)->leftSubtreeHeight > 1) {
-                    /* the tree is unbalanced, right subtree is too high, perform left rotation
-                            | = *p                 | = *p
-                            X                      Y
-                            / \                    / \
-                          a   Y       =>         X   c
-                              / \                / \
-                            b   c              a   b
-                    */
-                    __balancedBinarySearchTreeNode__ *tmp = (*p)->rightSubtree; // picture: tmp = Y
-                    (*p)->rightSubtree = tmp->leftSubtree;                      // picture: X.rightSubtree = b
-                    if (tmp->rightSubtree == NULL) { // the leftSubtree can not be NULL at this point otherwise tmp wouldn't be unbalanced
-                        /* handle trivial case that happens at the leaves level and could preserve unbalance even after rotation
-                                | = tmp                | = tmp
-                                A                      A
-                                  \                      \
-                                  C        =>            B 
-                                  /                        \ 
-                                B                          C                           
-                        */
-                        tmp->leftSubtree->rightSubtree = tmp; 
-                        tmp = tmp->leftSubtree;
-                        tmp->rightSubtree->leftSubtree = NULL;
-                        tmp->rightSubtree->leftSubtreeHeight = 0;
-                        tmp->rightSubtreeHeight = 1;
-                    }
-                    (*p)->rightSubtree = tmp->leftSubtree;
-                    (*p)->rightSubtreeHeight = tmp->leftSubtreeHeight;  // correct the hight information of (picture) b branch
-                    tmp->leftSubtree = (*p);                            // picture:Y.leftSubtree = X
-                    (*p) = tmp;                                         // Y becomes the new (subtree) root
-                    // correct the height information of left subtree - we know that left subtree exists (picture: X node)
-                    (*p)->leftSubtreeHeight = max ((*p)->leftSubtree->leftSubtreeHeight, (*p)->leftSubtree->rightSubtreeHeight) + 1; // the height of (sub)tree after rotation
-                } 
-                return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1; // the new height of (sub)tree
+
+                // get the memory for a new node from the pool
+                __balancedBinarySearchTreeNode__ *n = (__balancedBinarySearchTreeNode__ *) __nodePool__ ().allocate ();
+
+                if (n == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return { end (), false, err_bad_alloc };
+                }
+
+                memset (n, 0, sizeof (__balancedBinarySearchTreeNode__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->pair) Pair; 
+                #endif
+
+                n->pair.first = key;
+                n->pair.second = value;
+
+                    // in case of Strings - it is possible that key and value didn't get constructed, so just swap stack memory with parameters - this always succeeds
+                    if (is_same<keyType, String>::value)   // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                        if (!*(String *) &n->pair.first)                       // ... check if parameter construction is valid
+                            __swapStrings__ ((String *) &n->pair.first, (String *) &key); 
+                    if (is_same<valueType, String>::value) // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                        if (!*(String *) &n->pair.second)                     // ... check if parameter construction is valid
+                            __swapStrings__ ((String *) &n->pair.second, (String *) &value);
+
+                __size__ ++;
+                __height__ = __tree__::__link__ (n, parent, link, &__root__);
+                return { iterator (n, this), true, err_ok };
             }
     
-            signed char __erase__ (__balancedBinarySearchTreeNode__ **p, keyType& key) { // returns the height of balanced binary search tree or error
-                // 1. case: a leaf has been reached - key was not found
-                if ((*p) == NULL) {
+            template <class K>
+            signed char __erase__ (__balancedBinarySearchTreeNode__ **p, const K& key) { // returns the height of balanced binary search tree or error
+                __balancedBinarySearchTreeNode__ **root = p;
+
+                // find the node to be deleted
+                __balancedBinarySearchTreeNode__ *target = __find__ (key);
+                if (target == NULL) {
                     // log_e ("NOT_FOUND");
                     #ifdef USE_MAP_EXCEPTIONS
                         throw err_not_found;
@@ -800,124 +1523,20 @@
                     __errorFlags__ |= err_not_found;
                     return err_not_found; 
                 }
-                        
-                // 2. case: delete the node from the left subtree
-                if (key < (*p)->pair.first) {
-                    int h = __erase__ (&((*p)->leftSubtree), key);
-                    if (h < 0) return h; // < 0 means an error                    
-                    (*p)->leftSubtreeHeight = h;
-                    if ((*p)->rightSubtreeHeight - (*p)->leftSubtreeHeight > 1) {                        
-                        /* the tree is unbalanced, right subtree is too high, perform left rotation
-                                | = *p                 | = *p
-                                X                      Y
-                                / \                    / \
-                              a   Y       =>         X   c
-                                  / \                / \
-                                b   c              a   b
-                        */
-                        __balancedBinarySearchTreeNode__ *tmp = (*p)->rightSubtree; // picture: tmp = Y
-                        (*p)->rightSubtree = tmp->leftSubtree;                      // picture: X.rightSubtree = b
-                        (*p)->rightSubtreeHeight = tmp->leftSubtreeHeight;          // correct the hight information of (picture) b branch
-                        tmp->leftSubtree = (*p);                                    // picture:Y.leftSubtree = X
-                        (*p) = tmp;                                                 // Y becomes the new (subtree) root
-                        // correct height information of left subtree - we know that left subtree exists (picture: X node)
-                        (*p)->leftSubtreeHeight = max ((*p)->leftSubtree->leftSubtreeHeight, (*p)->leftSubtree->rightSubtreeHeight) + 1;
-                    }
-                    return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1;
-                }
-    
-                // 3. case: found
-                if (!((*p)->pair.first < key)) { // meaning at this point that key == (*p)->pair.first
-                    // 3.a. case: delete a node with no children
-                    if ((*p)->leftSubtree == NULL && (*p)->rightSubtree == NULL) {
-                        // remove the node
-                        delete (*p);
-                        (*p) = NULL;
-                        // __size__ --; // we'll do it if erase () function instead
-                        return err_ok;
-                    }
-                    // 3.b. case: delete a node with only left child 
-                    if ((*p)->rightSubtree == NULL) {
-                        // remove the node and replace it with its child
-                        __balancedBinarySearchTreeNode__ *tmp = (*p);
-                        (*p) = (*p)->leftSubtree;
-                        delete tmp;
-                        // __size__ --; // we'll do it if erase () 
-                        return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1; // return the new hight of a subtree
-                    }
-                    // 3.c. case: delete a node with only right child 
-                    if ((*p)->leftSubtree == NULL) {
-                        // remove the node and replace it with its child
-                        __balancedBinarySearchTreeNode__ *tmp = (*p);
-                        (*p) = (*p)->rightSubtree;
-                        delete tmp;
-                        // __size__ --; // we'll do it if erase () 
-                        return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1; // return the new hight of a subtree
-                    }
-                    // 3.d. case: deleting the node with both children
-                        // replace the node with its inorder successor (inorder predecessor would also do) and then delete it
-                        // find inorder successor = leftmost node from right subtree
-                        __balancedBinarySearchTreeNode__ *q = (*p)->rightSubtree; while (q->leftSubtree) q = q->leftSubtree;
-                        // remember inorder successor and then delete it from right subtree
-                        __balancedBinarySearchTreeNode__ tmp = *q;
-                        (*p)->rightSubtreeHeight = __erase__ (&((*p)->rightSubtree), q->pair.first);
-                        (*p)->pair = tmp.pair;
-                        if ((*p)->leftSubtreeHeight - (*p)->rightSubtreeHeight > 1) {
-                            /* the tree is unbalanced, left subtree is too high, perform right rotation
-                                    | = *p                 | = *p
-                                    Y                      X
-                                    / \                    / \
-                                  X   c       =>         a   Y
-                                  / \                        / \
-                                a   b                      b   c
-                            */
-                            __balancedBinarySearchTreeNode__ *tmp = (*p)->leftSubtree;  // picture: tmp = X
-                            (*p)->leftSubtree = tmp->rightSubtree;                      // picture: Y.leftSubtree = b
-                            (*p)->leftSubtreeHeight = tmp->rightSubtreeHeight;          // correct the hight information of (picture) b branch
-                            tmp->rightSubtree = (*p);                                   // picture: X.rightSubtree = Y
-                            (*p) = tmp;                                                 // X becomes the new (subtree) root
-                            // correct height information of right subtree - we know that right subtree exists (picture: Y node)
-                            (*p)->rightSubtreeHeight = max ((*p)->rightSubtree->leftSubtreeHeight, (*p)->rightSubtree->rightSubtreeHeight) + 1;
-                        }
-                        // __size__ --; // we'll do it if erase () 
-                        return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1;
-                } // 3. case: found
-                        
-                // 4. case: delete the node from the right subtree of the current node
-                    int h = __erase__ (&((*p)->rightSubtree), key);
-                    if (h < 0) return h; // < 0 means an error                    
-                    (*p)->rightSubtreeHeight = h;
-                    if ((*p)->leftSubtreeHeight - (*p)->rightSubtreeHeight > 1) {
-                        /* the tree is unbalanced, left subtree is too high, perform right rotation
-                                | = *p                 | = *p
-                                Y                      X
-                                / \                    / \
-                              X   c       =>         a   Y
-                              / \                        / \
-                            a   b                      b   c
-                        */
-                        __balancedBinarySearchTreeNode__ *tmp = (*p)->leftSubtree;  // picture: tmp = X
-                        (*p)->leftSubtree = tmp->rightSubtree;                      // picture: Y.leftSubtree = b
-                        (*p)->leftSubtreeHeight = tmp->rightSubtreeHeight;          // correct the hight information of (picture) b branch
-                        tmp->rightSubtree = (*p);                                   // picture: X.rightSubtree = Y
-                        (*p) = tmp;                                                 // X becomes the new (subtree) root
-                        // correct height information of right subtree - we know that right subtree exists (picture: Y node)
-                        (*p)->rightSubtreeHeight = max ((*p)->rightSubtree->leftSubtreeHeight, (*p)->rightSubtree->rightSubtreeHeight) + 1;
-                    }
-                
-                return max ((*p)->leftSubtreeHeight, (*p)->rightSubtreeHeight) + 1;
+                int8_t h = __tree__::__unlink__ (target, root);
+
+                // remove the node
+                __freeNode__ (target);
+                // __size__ --; // we'll do it if erase () function instead
+
+                return h; // the new height of (sub)tree
             }
     
             void __clear__ (__balancedBinarySearchTreeNode__ **p) {
-                if ((*p) == NULL) return;        // stop recursion at NULL
-                __clear__ (&(*p)->rightSubtree); // recursive delete right subtree  
-                __clear__ (&(*p)->leftSubtree);  // recursive delete left subtree
-
-                delete (*p);
-
-                (*p) = NULL;
-                __size__ --;
-                return;
+                while (__balancedBinarySearchTreeNode__ *n = __tree__::__takeFirst__ (p)) {
+                    __freeNode__ (n);
+                    __size__ --;
+                }
             }
 
             // swap strings by swapping their stack memory so constructors doesn't get called and nothing can go wrong like running out of memory meanwhile 
@@ -145,117 +145,9 @@
     #ifdef __LIST_HPP__
         template <typename forwardIterator>
         void __mergeSort__ (forwardIterator first, forwardIterator last) {
-            // check if number of elements is <= 1 so sorting isn't necessary
-            if (first.__p__ == last.__p__ || first.__p__->next == last.__p__)
-                return;
-            // form here on there are at least 2 elements in the list - this is inportant, since lists are only single linked so we can't change the pointer to the first element the same way as we can change the other pointers
-
+            // nodes are relinked in place, no working lists are needed and no elements are copied
             using listElementType = typename remove_reference<decltype(*first)>::type; 
-            list<listElementType> workingList [4];
-            list<listElementType> *pPrimaryOutputList = &workingList [0];
-            list<listElementType> *pStandbyOutputList = &workingList [1];
-            list<listElementType> *pFirstInputList = &workingList [2];
-            list<listElementType> *pSecondInputList = &workingList [3];
-
-            // do the first merging from first iterator to workingList [1] and workingList [0] and loacate min element meanwhile
-            auto pMin = first.__p__;
-            while (first.__p__->next != last.__p__) {
-                // 1. swith output lists if needed
-                if (pStandbyOutputList->__front__ && algorithm::smaller (first.__p__->next->element, pStandbyOutputList->back ())) {
-                    list<listElementType> *pTmpOutputList = pStandbyOutputList;
-                    pStandbyOutputList = pPrimaryOutputList;
-                    pPrimaryOutputList = pTmpOutputList;
-                }
-                // 2. is this min element so far?
-                if (algorithm::smaller (first.__p__->next->element, pMin->element))
-                    pMin = first.__p__->next;
-                // 3. add first.__p__->next to the back of pStandbyOutputListaryOutputList and remove it from p list
-                if (pStandbyOutputList->__front__ == NULL)
-                    pStandbyOutputList->__front__ = first.__p__->next;
-                if (pStandbyOutputList->__back__ == NULL)
-                    pStandbyOutputList->__back__ = first.__p__->next;
-                else {
-                    pStandbyOutputList->__back__->next = first.__p__->next;
-                    pStandbyOutputList->__back__ = pStandbyOutputList->__back__->next;
-                }
-                first.__p__->next = first.__p__->next->next;
-                pStandbyOutputList->__back__->next = NULL;
-            }
-
-            // swith first iterator element with min element so this part of list is sorted and we won't have to deal with it again
-            if (algorithm::smaller (pMin->element, first.__p__->element)) {
-                // swithc elements in the way if they are objects their constructors and destructors would not get called
-                //listElementType tmp;
-                char tmp [sizeof (listElementType)];
-                memcpy (tmp, &(first.__p__->element), sizeof (listElementType));
-                memcpy (&(first.__p__->element), &(pMin->element), sizeof (listElementType));
-                memcpy (&(pMin->element), tmp, sizeof (listElementType));
-            }
-
-            // if we've only got a single output list then the sorting is already done and we only have to move primaryOutputList back to front iterator
-            while (pStandbyOutputList->__front__) {
-                // it we'we got 2 output lists the elements are not yet in order - do the mergesort magic here in the right way, otherwise we won't get O (n log n) time complexity
-
-                    // switch input and output lists so all the elements are in two input lists and both output lists are empty
-                    list<listElementType> *pTmpList = pPrimaryOutputList;
-                    pPrimaryOutputList = pFirstInputList;
-                    pFirstInputList = pStandbyOutputList;
-                    pStandbyOutputList = pSecondInputList;
-                    pSecondInputList = pTmpList;
-
-                    // merge the input lists into output lists
-                    list<listElementType> *pInputList = NULL;
-                    listElementType *lastElementMerged = NULL;
-
-                    while (pFirstInputList->__front__ || pSecondInputList->__front__) { // while there is any input
-
-                        if (pFirstInputList->__front__) {
-                            pInputList = pFirstInputList;
-                            if (pSecondInputList->__front__) { // there are both inputs available    
-                                if (lastElementMerged) { // pick the smallest element from inputs that is bigger than the last element already in output (this would create longer sorted output sequences)    
-                                    if (algorithm::smaller (pSecondInputList->__front__->element, pFirstInputList->__front__->element) && !algorithm::smaller (pSecondInputList->__front__->element, *lastElementMerged)) { // greater or equal
-                                        pInputList = pSecondInputList;
-                                    }
-                                } else { // just pick a smaller of both inputs (this would create longer sorted output sequences)
-                                    if (algorithm::smaller (pSecondInputList->__front__->element, pFirstInputList->__front__->element)) {
-                                        pInputList = pSecondInputList;
-                                    }
-                                }
-                            }
-                            // else there is only the first input available, we don't have to do anything
-                        } else { // there is only the second input available
-                            pInputList = pSecondInputList;
-                        }
-
-                        // we have selected the input, now see if we have to swithc the outputs
-                        if (lastElementMerged && algorithm::smaller (pInputList->__front__->element, *lastElementMerged)) {
-                            pTmpList = pPrimaryOutputList;
-                            pPrimaryOutputList = pStandbyOutputList;
-                            pStandbyOutputList = pTmpList;
-                        } 
-
-                        // 1. insert element to the output list
-                        auto pTmp = pInputList->__front__->next;
-                        pInputList->__front__->next = NULL;
-                        if (pPrimaryOutputList->__front__ == NULL)
-                            pPrimaryOutputList->__front__ = pInputList->__front__;
-                        if (pPrimaryOutputList->__back__ != NULL)
-                            pPrimaryOutputList->__back__->next = pInputList->__front__;
-                        pPrimaryOutputList->__back__ = pInputList->__front__;
-                        // 2. remove it from pInputList list
-                        pInputList->__front__ = pTmp;
-                        if (pInputList->__front__ == NULL)
-                            pInputList->__back__ = NULL;
-                        // 3. remember the last element merged so far in this iteration
-                        lastElementMerged = &(pPrimaryOutputList->__back__->element);
-                    } // merging inputs into outputs
-
-            } // while we are getting more than one output
-
-            // move all elements from (a single, which is) primaryOutputList back to front iterator
-            pPrimaryOutputList->__back__ = last.__p__;
-            first.__p__->next = pPrimaryOutputList->__front__;
-            pPrimaryOutputList->__front__ = NULL;
+            list<listElementType>::__sortRange__ (first.__p__, last.__p__, [] (const listElementType& a, const listElementType& b) { return algorithm::smaller (a, b); });
         }
     #endif
 
@@ -504,4 +396,16 @@
             helper.sort (first, last);
         }
 
+
+       /*
+        *   (merge)sort intrusive list elements in [first, last) iterators, objects are only relinked, never copied
+        */
+
+    #ifdef __INTRUSIVE_LIST_HPP__
+        template <class T, intrusive_list_hook T::*hook>
+        void sort (intrusive_list_iterator<T, hook> first, intrusive_list_iterator<T, hook> last) {
+            intrusive_list<T, hook>::__sort__ (first, last, [] (const T& a, const T& b) { return algorithm::smaller (a, b); });
+        }
+    #endif
+
 #endif
\ No newline at end of file
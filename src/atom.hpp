@@ -0,0 +1,284 @@
+/*
+ *  atom.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Interned strings. The atom table stores each distinct string only once, in chunks of heap or PSRAM that are never moved or freed while the
+ *  table exists, so the stored copy has a stable address that uniquely identifies the string. An atom is just this address, so comparing two
+ *  atoms (as keys of Map or unordered_map, for example) is a single pointer comparison instead of comparing all the characters.
+ *
+ *  Atoms are ordered by their addresses, not alphabetically, so a Map with atom keys iterates in some arbitrary (but stable) order.
+ *
+ *  atom_table functions are not thread-safe.
+ *
+ *  March 21, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __ATOM_HPP__
+    #define __ATOM_HPP__
+
+
+    #include "unordered_map.hpp"    // error flags, memory type and hash functions are shared with unordered_map
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want atom_table to throw exceptions (the same setting as for Map)
+
+    #ifndef ATOM_TABLE_CHUNK_SIZE
+        #ifdef ARDUINO_ARCH_AVR
+            #define ATOM_TABLE_CHUNK_SIZE 64    // bytes of string storage allocated at once, longer strings get their own chunk
+        #else
+            #define ATOM_TABLE_CHUNK_SIZE 512
+        #endif
+    #endif
+
+
+    class atom_table {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+
+            atom_table () {}
+
+            atom_table (const atom_table&) = delete;
+            atom_table& operator = (const atom_table&) = delete;
+
+
+           /*
+            *  atom_table destructor - free the memory occupied by strings and the index, the atoms of this table are not valid any more
+            */
+
+            ~atom_table () {
+                while (__chunks__ != NULL) {
+                    __chunk__ *next = __chunks__->next;
+                    free (__chunks__);
+                    __chunks__ = next;
+                }
+                if (__index__ != NULL)
+                    free (__index__);
+            }
+
+
+           /*
+            *  Returns the stored copy of the string, storing it first if it is not in the table yet, or NULL if there is not enough memory.
+            *
+            *    const char *s = table.intern ("home/livingroom/temperature");
+            */
+
+            const char *intern (const char *s) {
+                if (s == NULL)
+                    return NULL;
+                uint32_t hash = __unorderedMapFnv1a__ (s);
+                size_t i;
+                if (__find__ (s, hash, &i))
+                    return __index__ [i].s;
+
+                // not found, make room in the index first, so that the string is not stored if the index can't grow
+                if (4 * (__size__ + 1) > 3 * __capacity__) {
+                    if (!__grow__ ())
+                        return NULL;
+                    __find__ (s, hash, &i);
+                }
+                const char *copy = __store__ (s, strlen (s) + 1);
+                if (copy == NULL)
+                    return NULL;
+                __index__ [i] = { hash, copy };
+                __size__ ++;
+                return copy;
+            }
+
+
+           /*
+            *  Returns the stored copy of the string or NULL if it has not been interned, never stores anything.
+            */
+
+            const char *find (const char *s) const {
+                size_t i;
+                return s != NULL && __find__ (s, __unorderedMapFnv1a__ (s), &i) ? __index__ [i].s : NULL;
+            }
+
+
+           /*
+            *  Returns the number of distinct strings and the number of bytes the table occupies (strings with their chunks and the index).
+            */
+
+            size_t size () const { return __size__; }
+
+            size_t bytes () const { return __bytes__ + __capacity__ * sizeof (__slot__); }
+
+
+           /*
+            *  The table that atoms use, created at first use.
+            */
+
+            static atom_table& shared () {
+                static atom_table table;
+                return table;
+            }
+
+
+        private:
+
+            struct __slot__ {
+                uint32_t hash;
+                const char *s;          // NULL for empty slots
+            };
+
+            struct __chunk__ {
+                __chunk__ *next;
+                size_t size;
+                size_t used;
+                // characters follow
+            };
+
+            __slot__ *__index__ = NULL;
+            size_t __capacity__ = 0;    // power of 2
+            size_t __size__ = 0;
+            __chunk__ *__chunks__ = NULL;
+            size_t __bytes__ = 0;
+
+            static void *__allocate__ (size_t size) {
+                #if MAP_MEMORY_TYPE == PSRAM_MEM
+                    return ps_malloc (size);
+                #else
+                    return malloc (size);
+                #endif
+            }
+
+            void __outOfMemory__ () {
+                #ifdef USE_MAP_EXCEPTIONS
+                    throw err_bad_alloc;
+                #endif
+                __errorFlags__ |= err_bad_alloc;
+            }
+
+            // linear probing, returns true if the string is found, *i is its slot or the empty slot where it should be inserted (0 if there is no index yet)
+            bool __find__ (const char *s, uint32_t hash, size_t *i) const {
+                *i = 0;
+                if (__index__ == NULL)
+                    return false;
+                for (*i = hash & (__capacity__ - 1); __index__ [*i].s != NULL; *i = (*i + 1) & (__capacity__ - 1))
+                    if (__index__ [*i].hash == hash && !strcmp (__index__ [*i].s, s))
+                        return true;
+                return false;
+            }
+
+            bool __grow__ () {
+                size_t capacity = __capacity__ ? 2 * __capacity__ : 16;
+                __slot__ *index = (__slot__ *) __allocate__ (capacity * sizeof (__slot__));
+                if (index == NULL) {
+                    __outOfMemory__ ();
+                    return false;
+                }
+                memset (index, 0, capacity * sizeof (__slot__));
+                for (size_t j = 0; j < __capacity__; j++)
+                    if (__index__ [j].s != NULL) {
+                        size_t i = __index__ [j].hash & (capacity - 1);
+                        while (index [i].s != NULL)
+                            i = (i + 1) & (capacity - 1);
+                        index [i] = __index__ [j];
+                    }
+                if (__index__ != NULL)
+                    free (__index__);
+                __index__ = index;
+                __capacity__ = capacity;
+                return true;
+            }
+
+            // copies the string into the current chunk or into a new one, the characters never move afterwards
+            const char *__store__ (const char *s, size_t length) {
+                __chunk__ *chunk = __chunks__;
+                if (chunk == NULL || chunk->size - chunk->used < length) {
+                    size_t size = length > ATOM_TABLE_CHUNK_SIZE ? length : ATOM_TABLE_CHUNK_SIZE;
+                    chunk = (__chunk__ *) __allocate__ (sizeof (__chunk__) + size);
+                    if (chunk == NULL) {
+                        __outOfMemory__ ();
+                        return NULL;
+                    }
+                    chunk->size = size;
+                    chunk->used = 0;
+                    if (__chunks__ != NULL && size > ATOM_TABLE_CHUNK_SIZE) { // a long string fills its own chunk, keep filling the current one
+                        chunk->next = __chunks__->next;
+                        __chunks__->next = chunk;
+                    } else {
+                        chunk->next = __chunks__;
+                        __chunks__ = chunk;
+                    }
+                    __bytes__ += sizeof (__chunk__) + size;
+                }
+                char *copy = (char *) (chunk + 1) + chunk->used;
+                memcpy (copy, s, length);
+                chunk->used += length;
+                return copy;
+            }
+
+    };
+
+
+   /*
+    *  An atom is a handle of a string interned in atom_table::shared (). Atoms of equal strings are equal, so they compare in O (1):
+    *
+    *    Map<atom, void (*) (const char *)> handlers;
+    *    handlers [atom ("home/livingroom/temperature")] = onTemperature;
+    *
+    *    atom topic = atom::find (receivedTopic);   // doesn't store strings that were never interned
+    *    auto h = handlers.find (topic);
+    *
+    *  A default constructed atom (or an atom that couldn't be interned because of lack of memory) is empty and converts to false.
+    */
+
+    class atom {
+
+        public:
+
+            atom () {}
+
+            explicit atom (const char *s) : __s__ (atom_table::shared ().intern (s)) {}
+
+            explicit atom (const String& s) : __s__ (atom_table::shared ().intern (s.c_str ())) {}
+
+            // returns the atom of an already interned string or an empty atom, without storing the string
+            static atom find (const char *s) { atom a; a.__s__ = atom_table::shared ().find (s); return a; }
+
+            static atom find (const String& s) { return find (s.c_str ()); }
+
+            const char *c_str () const { return __s__ != NULL ? __s__ : ""; }
+
+            explicit operator bool () const { return __s__ != NULL; }
+
+            // atoms of the same table are equal only if they point to the same stored string
+            bool operator == (const atom& other) const { return __s__ == other.__s__; }
+            bool operator != (const atom& other) const { return __s__ != other.__s__; }
+            bool operator < (const atom& other) const { return __s__ < other.__s__; }
+            bool operator > (const atom& other) const { return __s__ > other.__s__; }
+
+            // unordered_map hashes the address, the characters have already been hashed when the string was interned
+            friend uint32_t __unorderedMapHash__ (const atom& key) { return __unorderedMapHash__ ((uint32_t) (uintptr_t) key.__s__); }
+
+            #ifdef __OSTREAM_HPP__
+                // print atom's string to ostream
+                friend ostream& operator << (ostream& os, const atom& a) {
+                    os << a.c_str ();
+                    return os;
+                }
+            #endif
+
+        private:
+
+            const char *__s__ = NULL;
+
+    };
+
+
+#endif
@@ -0,0 +1,874 @@
+/*
+ *  btree_map.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  The data storage is internaly implemented as B-tree. Each node is BTREE_MAP_NODE_SIZE bytes large (a few cache lines) and holds many sorted pairs,
+ *  so a lookup reads only a few nodes and searches each of them in a contiguous block of memory. This pays off when the memory is slow (PSRAM)
+ *  and when there are many small pairs, since the nodes need no per-pair pointers. The interface is the same as the one of Map.
+ *
+ *  btree_map functions are not thread-safe.
+ *
+ *  February 21, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __BTREE_MAP_HPP__
+    #define __BTREE_MAP_HPP__
+
+
+    #include "Map.hpp" // error flags, memory type, node pool and key comparison are shared with Map
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want btree_map to throw exceptions (the same setting as for Map)
+
+    #ifndef BTREE_MAP_NODE_SIZE
+        #ifdef ARDUINO_ARCH_AVR
+            #define BTREE_MAP_NODE_SIZE 64      // approximate size of the node in bytes, AVR boards have no cache and not much memory
+        #else
+            #define BTREE_MAP_NODE_SIZE 256     // approximate size of the node in bytes, a multiple of cache line (32 bytes on ESP32 PSRAM cache, 64 on most other CPUs)
+        #endif
+    #endif
+
+    #ifndef BTREE_MAP_NODES_PER_SLAB
+        #ifdef ARDUINO_ARCH_AVR
+            #define BTREE_MAP_NODES_PER_SLAB 1  // number of nodes btree_map's node pool allocates at once
+        #else
+            #define BTREE_MAP_NODES_PER_SLAB 4  // number of nodes btree_map's node pool allocates at once, the nodes are large already
+        #endif
+    #endif
+
+
+    template <class keyType, class valueType> class btree_map {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+            struct Pair {
+                keyType first;          // key
+                valueType second;       // value
+            };
+
+
+           /*
+            *  Constructor of btree_map with no pairs allows the following kinds of creation of btree_map pairs:
+            *
+            *    btree_map<int, String> btA;
+            */
+
+            btree_map () {}
+
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+               /*
+                *  Constructor of btree_map from brace enclosed initializer list allows the following kinds of creation of btree_map pairs:
+                *
+                *     btree_map<int, String> btB = { {1, "one"}, {2, "two"} };
+                */
+
+                btree_map (std::initializer_list<Pair> il) {
+                    for (auto& i: il)
+                        if (insert (i.first, i.second) == err_bad_alloc)
+                            return;
+                }
+          #endif
+
+                // constructor accepting the array by reference, since AVR boards do not support initializer lists
+                template <int N>
+                btree_map (const typename btree_map<keyType, valueType>::Pair (&array) [N]) {
+                    for (int i = 0; i < N; ++i)
+                        if (insert (array [i].first, array [i].second) == err_bad_alloc)
+                            break;
+                }
+
+
+           /*
+            *  btree_map destructor - free the memory occupied by pairs
+            */
+
+            ~btree_map () { __clear__ (__root__); }
+
+
+           /*
+            *  Returns the number of pairs.
+            */
+
+            int size () const { return __size__; }
+
+
+           /*
+            *  Returns the height of B-tree (the number of nodes on the path from the root to any leaf).
+            */
+
+            signed char height () const { return __height__; }
+
+
+           /*
+            *  Checks if there are no pairs.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Clears all the pairs.
+            */
+
+            void clear () {
+                __clear__ (__root__);
+                __root__ = NULL;
+                __size__ = 0;
+                __height__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  Copy-constructor and assignment operator copy the pairs of the other btree_map.
+            *
+            *     btree_map<int, String> btC = btB;
+            *     btC = { {3, "tree"}, {4, "four"} };
+            */
+
+            btree_map (btree_map& other) {
+                for (auto& p: other)
+                    if (insert (p.first, p.second) == err_bad_alloc)
+                        break;
+                __errorFlags__ |= other.__errorFlags__;
+            }
+
+            btree_map* operator = (btree_map other) {
+                clear ();
+                for (auto& p: other)
+                    if (insert (p.first, p.second) == err_bad_alloc)
+                        break;
+                __errorFlags__ |= other.__errorFlags__;
+                return this;
+            }
+
+
+           /*
+            *  [] operator enables btree_map pairs to be conveniently addressed by their keys like:
+            *
+            *    value = bt [key];
+            *       or
+            *    bt [key] = value;
+            *
+            *  Operator searches for the pair with the key. It it can't be found it inserts a new pair.
+            *  Error handling can be somewhat tricky. It may be a good idea to use USE_MAP_EXCEPTIONS if using [] operator.
+            */
+
+            template <class K>
+            valueType &operator [] (const K& key) {
+                static valueType dummyValue1 = {};
+                static valueType dummyValue2 = {};
+
+                if (is_same<K, String>::value)            // if key is of type String ...
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        dummyValue1 = dummyValue2;
+                        return dummyValue1;               // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
+                    }
+
+                uint8_t i;
+                __btreeNode__ *n = __find__ (key, &i);
+                if (n != NULL)
+                    return n->pair (i).second;            // found
+                // else                                   // not found, insert a new pair
+                keyType newKey = key;
+                if (is_same<keyType, String>::value)      // if key is of type String ...
+                    if (!*(String *) &newKey) {           // ... check if construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        dummyValue1 = dummyValue2;
+                        return dummyValue1;
+                    }
+                if (__insert__ (newKey, dummyValue2, &n, &i) == err_ok)
+                    return n->pair (i).second;
+                // else there was some kind of error
+                dummyValue1 = dummyValue2;
+                return dummyValue1;
+            }
+
+            template <class K>
+            const valueType &operator [] (const K& key) const {
+                static valueType dummyValue1 = {};
+                static valueType dummyValue2 = {};
+
+                uint8_t i;
+                __btreeNode__ *n = __find__ (key, &i);
+                if (n != NULL)
+                    return n->pair (i).second;            // found
+                // else                                   // not found
+                dummyValue1 = dummyValue2;
+                return dummyValue1;
+            }
+
+
+           /*
+            *  Checks if there is a pair with the key. Key can be of any type comparable to keyType.
+            */
+
+            template <class K>
+            bool contains (const K& key) const { uint8_t i; return __find__ (key, &i) != NULL; }
+
+
+           /*
+            *  Returns the pointer to the value of the pair with the key or NULL if there is no such pair. Key can be of any type comparable to keyType.
+            */
+
+            template <class K>
+            valueType *get_if (const K& key) {
+                uint8_t i;
+                __btreeNode__ *n = __find__ (key, &i);
+                return n ? &(n->pair (i).second) : NULL;
+            }
+
+            template <class K>
+            const valueType *get_if (const K& key) const {
+                uint8_t i;
+                __btreeNode__ *n = __find__ (key, &i);
+                return n ? &(n->pair (i).second) : NULL;
+            }
+
+
+           /*
+            *  Erases the pair identified by key.
+            *
+            *  Returns OK if succeeds and error err_not_found or err_bad_alloc if String key parameter could not be constructed.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+
+                if (is_same<K, String>::value)            // if key is of type String ...
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+
+                return __erase__ (key);
+            }
+
+
+           /*
+            *  Inserts a new pair, returns OK or one of the errors.
+            */
+
+            signed char insert (const Pair& pair) { return insert (pair.first, pair.second); }
+
+            signed char insert (const keyType& key, const valueType& value) {
+
+                if (is_same<keyType, String>::value)      // if key is of type String ...
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+
+                if (is_same<valueType, String>::value)    // if value is of type String ...
+                    if (!*(String *) &value) {            // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+
+                __btreeNode__ *n;
+                uint8_t i;
+                return __insert__ (key, value, &n, &i);
+            }
+
+
+           /*
+            *   Iterator
+            *
+            *   Example:
+            *    for (auto pair: bt)
+            *        Serial.println (String (pair.first) + "-" + String (pair.second));
+            */
+
+        private:
+
+            struct __btreeNode__;                // forward private declaration
+
+        public:
+
+            class iterator {
+
+              public:
+
+                // there are 2 cases when constructor gets called: begin (pointToFirstPair = true) and end (pointToFirstPair = false)
+                iterator (btree_map* bt, bool pointToFirstPair) {
+                    __bt__ = bt;
+                    if (!pointToFirstPair || bt->__root__ == NULL) // end () doesn't point to any node
+                        return;
+                    __node__ = bt->__root__;                       // else find the lowest pair, this would be the first one in the leftmost leaf
+                    while (!__node__->leaf)
+                        __node__ = __node__->child (0);
+                }
+
+                // the iterator pointing to a pair that has already been found
+                iterator (btree_map::__btreeNode__ *node, uint8_t index, btree_map* bt) {
+                    __bt__ = bt;
+                    __node__ = node;
+                    __index__ = node ? index : 0;
+                }
+
+                // * operator
+                Pair& operator *() { return __node__->pair (__index__); }
+
+                // -> operator
+                Pair * operator -> () { return &__node__->pair (__index__); }
+
+                // ++ (prefix) increment moves to the next pair
+                iterator& operator ++ () {
+                    if (!__node__->leaf) {                          // the next pair is the first one in the leftmost leaf of the right child
+                        __node__ = __node__->child (__index__ + 1);
+                        while (!__node__->leaf)
+                            __node__ = __node__->child (0);
+                        __index__ = 0;
+                        return *this;
+                    }
+                    __index__ ++;
+                    while (__index__ >= __node__->count) {          // climb up until we come from a child that has a pair on its right
+                        btree_map::__btreeNode__ *p = __node__->parent;
+                        if (p == NULL) {                            // no more pairs, this is end ()
+                            __node__ = NULL;
+                            __index__ = 0;
+                            break;
+                        }
+                        __index__ = __childIndex__ (p, __node__);
+                        __node__ = p;
+                    }
+                    return *this;
+                }
+
+                // -- (prefix) decrement moves to the previous pair
+                iterator& operator -- () {
+                    if (__node__ == NULL) {                         // we came here with -- end (), start with the last pair in the rightmost leaf
+                        __node__ = __bt__->__root__;
+                        if (__node__ == NULL)
+                            return *this;
+                        while (!__node__->leaf)
+                            __node__ = __node__->child (__node__->count);
+                        __index__ = __node__->count - 1;
+                    } else if (!__node__->leaf) {                   // the previous pair is the last one in the rightmost leaf of the left child
+                        __node__ = __node__->child (__index__);
+                        while (!__node__->leaf)
+                            __node__ = __node__->child (__node__->count);
+                        __index__ = __node__->count - 1;
+                    } else if (__index__ > 0) {
+                        __index__ --;
+                    } else {                                        // climb up until we come from a child that has a pair on its left
+                        while (true) {
+                            btree_map::__btreeNode__ *p = __node__->parent;
+                            if (p == NULL) {
+                                __node__ = NULL;
+                                break;
+                            }
+                            uint8_t j = __childIndex__ (p, __node__);
+                            __node__ = p;
+                            if (j > 0) {
+                                __index__ = j - 1;
+                                break;
+                            }
+                        }
+                    }
+                    return *this;
+                }
+
+                // C++ will stop iterating when != operator returns false, this is when all pairs have been visited
+                friend bool operator != (const iterator& a, const iterator& b) { return a.__node__ != b.__node__ || a.__index__ != b.__index__; }
+                friend bool operator == (const iterator& a, const iterator& b) { return a.__node__ == b.__node__ && a.__index__ == b.__index__; }
+
+                // this will tell if iterator is valid (if there are not elements the iterator can not be valid)
+                operator bool () const { return __bt__->size () > 0; }
+
+            private:
+
+                btree_map* __bt__ = NULL;                           // needed for -- end () only
+                btree_map::__btreeNode__ *__node__ = NULL;      // NULL means end ()
+                uint8_t __index__ = 0;                              // the position of the pair in the node
+
+            };
+
+            iterator begin () { return iterator (this, true); }
+            iterator end ()   { return iterator (this, false); }
+
+
+           /*
+            *  Returns an iterator to the pair with the key, if key is found, end () if it is not.
+            */
+
+            template <class K>
+            iterator find (const K& key) {
+
+                if (is_same<K, String>::value)            // if key is of type String ...
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return end ();
+                    }
+
+                uint8_t i;
+                __btreeNode__ *n = __find__ (key, &i);
+                return iterator (n, i, this);
+            }
+
+
+
+
+           /*
+            *  lower_bound returns an iterator to the first pair with the key not less than the given key, upper_bound returns an iterator to the first pair
+            *  with the key greater than the given key, end () if there is no such pair. Example:
+            *
+            *    // all the readings between t1 and t2
+            *    auto last = readings.upper_bound (t2);
+            *    for (auto it = readings.lower_bound (t1); it != last; ++ it)
+            *        Serial.println (it->second);
+            */
+
+            template <class K>
+            iterator lower_bound (const K& probe) {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __btreeNode__ *bound = NULL;
+                uint8_t boundIndex = 0;
+                for (__btreeNode__ *n = __root__; n; ) {
+                    uint8_t i = __lowerBound__ (n, key);
+                    if (i < n->count) {                     // n's pair is a candidate, but there may be a lower one in the child on its left
+                        bound = n;
+                        boundIndex = i;
+                    }
+                    n = n->leaf ? NULL : n->child (i);
+                }
+                return iterator (bound, boundIndex, this);
+            }
+
+            template <class K>
+            iterator upper_bound (const K& probe) {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __btreeNode__ *bound = NULL;
+                uint8_t boundIndex = 0;
+                for (__btreeNode__ *n = __root__; n; ) {
+                    uint8_t i = __upperBound__ (n, key);
+                    if (i < n->count) {                     // n's pair is a candidate, but there may be a lower one in the child on its left
+                        bound = n;
+                        boundIndex = i;
+                    }
+                    n = n->leaf ? NULL : n->child (i);
+                }
+                return iterator (bound, boundIndex, this);
+            }
+
+
+           /*
+            *  A range of pairs [first, second) that can be iterated through like:
+            *
+            *    for (auto& pair: bt.equal_range (key))
+            *        Serial.println (pair.second);
+            */
+
+            struct range {
+                iterator first;
+                iterator second;
+
+                iterator begin () { return first; }
+                iterator end () { return second; }
+            };
+
+            // returns the range of the pairs with the key (which has at most one pair since btree_map keys are unique)
+            template <class K>
+            range equal_range (const K& key) { return { lower_bound (key), upper_bound (key) }; }
+
+            #ifdef __OSTREAM_HPP__
+                // print btree_map to ostream
+                friend ostream& operator << (ostream& os, btree_map& bt) {
+                    bool first = true;
+                    for (auto& e : bt) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << "{" << e.first << "," << e.second << "}";
+                    }
+                    return os;
+                }
+            #endif
+
+        private:
+
+            // the number of pairs that fit into a node, it is always odd (and at least 3) so that a full node splits into two halves and a pair that goes up to the parent
+            static const int __pairsThatFit__ = (BTREE_MAP_NODE_SIZE - sizeof (void *) - 2) / sizeof (Pair);
+            static const int __maxPairs__ = __pairsThatFit__ < 3 ? 3 : __pairsThatFit__ > 255 ? 255 : __pairsThatFit__ - 1 + __pairsThatFit__ % 2;
+            static const int __minPairs__ = __maxPairs__ / 2; // all the nodes except the root hold at least that many pairs
+
+            // B-tree nodes: leaves hold only the pairs, internal nodes hold the links to their children as well
+
+            struct __internalNode__;
+
+            struct __btreeNode__ {
+                __btreeNode__ *parent;                                   // parent links enable iterating without a stack
+                uint8_t count;                                      // the number of pairs in the node
+                bool leaf;
+                alignas (Pair) char pairs [__maxPairs__ * sizeof (Pair)]; // sorted pairs, they are constructed in place and moved with memcpy
+
+                Pair& pair (uint8_t i) { return ((Pair *) pairs) [i]; }
+                __btreeNode__ *& child (uint8_t i) { return ((__internalNode__ *) this)->children [i]; }
+            };
+
+            struct __internalNode__ : __btreeNode__ {
+                __btreeNode__ *children [__maxPairs__ + 1];              // child i holds the keys between pair i - 1 and pair i
+            };
+
+            __btreeNode__ *__root__ = NULL;
+            int __size__ = 0;
+            int8_t __height__ = 0;
+
+            // node memory comes from two pools, one for the leaves and one for the (larger) internal nodes
+            typedef __mapNodePool__<sizeof (__btreeNode__), BTREE_MAP_NODES_PER_SLAB> __leafPool_t__;
+            typedef __mapNodePool__<sizeof (__internalNode__), BTREE_MAP_NODES_PER_SLAB> __internalPool_t__;
+            #ifdef MAP_SHARED_NODE_POOL
+                __leafPool_t__& __leafPool__ () { return __leafPool_t__::shared (); }
+                __internalPool_t__& __internalPool__ () { return __internalPool_t__::shared (); }
+            #else
+                __leafPool_t__ __ownLeafPool__;
+                __internalPool_t__ __ownInternalPool__;
+                __leafPool_t__& __leafPool__ () { return __ownLeafPool__; }
+                __internalPool_t__& __internalPool__ () { return __ownInternalPool__; }
+            #endif
+
+            __btreeNode__ *__newNode__ (bool leaf) {
+                __btreeNode__ *n = (__btreeNode__ *) (leaf ? __leafPool__ ().allocate () : __internalPool__ ().allocate ());
+                if (n == NULL)
+                    return NULL;
+                n->parent = NULL;
+                n->count = 0;
+                n->leaf = leaf;
+                return n;
+            }
+
+            // the pairs must already be destroyed or moved to some other node
+            void __freeNode__ (__btreeNode__ *n) {
+                if (n->leaf)
+                    __leafPool__ ().deallocate (n);
+                else
+                    __internalPool__ ().deallocate (n);
+            }
+
+            static void __destroyPair__ (Pair& p) {
+                p.~Pair ();
+            }
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            // internal functions
+
+            // binary search inside the node: the position of the first pair with the key not less than (lower bound) or greater than (upper bound) key
+            template <class K>
+            static uint8_t __lowerBound__ (__btreeNode__ *n, const K& key) {
+                uint8_t from = 0, to = n->count;
+                while (from < to) {
+                    uint8_t middle = (from + to) / 2;
+                    if (__mapLess__ (n->pair (middle).first, key))
+                        from = middle + 1;
+                    else
+                        to = middle;
+                }
+                return from;
+            }
+
+            template <class K>
+            static uint8_t __upperBound__ (__btreeNode__ *n, const K& key) {
+                uint8_t from = 0, to = n->count;
+                while (from < to) {
+                    uint8_t middle = (from + to) / 2;
+                    if (__mapLess__ (key, n->pair (middle).first))
+                        to = middle;
+                    else
+                        from = middle + 1;
+                }
+                return from;
+            }
+
+            // the position of the child in its parent's children
+            static uint8_t __childIndex__ (__btreeNode__ *parent, __btreeNode__ *child) {
+                uint8_t i = 0;
+                while (parent->child (i) != child)
+                    i ++;
+                return i;
+            }
+
+            // returns the node with the key and the position of the pair in it or NULL if it is not found
+            template <class K>
+            __btreeNode__ *__find__ (const K& probe, uint8_t *index) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __btreeNode__ *n = __root__;
+                while (n) {
+                    uint8_t i = __lowerBound__ (n, key);
+                    if (i < n->count && !__mapLess__ (key, n->pair (i).first)) {
+                        *index = i;
+                        return n;                                   // found
+                    }
+                    n = n->leaf ? NULL : n->child (i);              // continue searching in the child between the smaller and the greater key
+                }
+                return NULL;                                        // not found
+            }
+
+            // splits the full child i of node p into two halves, the middle pair goes up into p, returns false if there is no memory for the new node
+            bool __splitChild__ (__btreeNode__ *p, uint8_t i) {
+                __btreeNode__ *left = p->child (i);
+                __btreeNode__ *right = __newNode__ (left->leaf);
+                if (right == NULL)
+                    return false;
+                right->parent = p;
+                right->count = __minPairs__;
+                memcpy ((void *) &right->pair (0), (void *) &left->pair (__minPairs__ + 1), __minPairs__ * sizeof (Pair));
+                if (!left->leaf)
+                    for (uint8_t j = 0; j <= __minPairs__; j++) {
+                        right->child (j) = left->child (__minPairs__ + 1 + j);
+                        right->child (j)->parent = right;
+                    }
+                // make room for the middle pair and the new child in p
+                memmove ((void *) &p->pair (i + 1), (void *) &p->pair (i), (p->count - i) * sizeof (Pair));
+                memmove (&p->child (i + 2), &p->child (i + 1), (p->count - i) * sizeof (__btreeNode__ *));
+                memcpy ((void *) &p->pair (i), (void *) &left->pair (__minPairs__), sizeof (Pair));
+                p->child (i + 1) = right;
+                p->count ++;
+                left->count = __minPairs__;
+                return true;
+            }
+
+            // inserts a new pair, splitting the full nodes on the way down so that there is always room in the leaf, returns OK or one of the errors and the position of the new pair
+            signed char __insert__ (const keyType& key, const valueType& value, __btreeNode__ **pNode, uint8_t *pIndex) {
+                if (__root__ == NULL) {
+                    __root__ = __newNode__ (true);
+                    if (__root__ == NULL) {
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+                    __height__ = 1;
+                }
+                if (__root__->count == __maxPairs__) {              // split the full root, the tree grows one level higher
+                    __btreeNode__ *newRoot = __newNode__ (false);
+                    if (newRoot == NULL) {
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+                    newRoot->child (0) = __root__;
+                    __root__->parent = newRoot;
+                    if (!__splitChild__ (newRoot, 0)) {
+                        __root__->parent = NULL;
+                        __freeNode__ (newRoot);
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+                    __root__ = newRoot;
+                    __height__ ++;
+                }
+
+                __btreeNode__ *n = __root__;
+                uint8_t i;
+                while (true) {
+                    i = __lowerBound__ (n, key);
+                    if (i < n->count && !__mapLess__ (key, n->pair (i).first)) {
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_not_unique;
+                        #endif
+                        __errorFlags__ |= err_not_unique;
+                        return err_not_unique;
+                    }
+                    if (n->leaf)
+                        break;
+                    if (n->child (i)->count == __maxPairs__) {      // split the full child before descending into it
+                        if (!__splitChild__ (n, i)) {
+                            #ifdef USE_MAP_EXCEPTIONS
+                                throw err_bad_alloc;
+                            #endif
+                            __errorFlags__ |= err_bad_alloc;
+                            return err_bad_alloc;
+                        }
+                        continue;                                   // the middle pair of the child is now in n, check n again
+                    }
+                    n = n->child (i);
+                }
+
+                // insert the pair into the leaf
+                memmove ((void *) &n->pair (i + 1), (void *) &n->pair (i), (n->count - i) * sizeof (Pair));
+                memset ((void *) &n->pair (i), 0, sizeof (Pair));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->pair (i)) Pair { key, value };
+                #else
+                    n->pair (i).first = key;
+                    n->pair (i).second = value;
+                #endif
+
+                // in case of Strings - it is possible that key and value didn't get constructed
+                if ((is_same<keyType, String>::value && !*(String *) &n->pair (i).first) || (is_same<valueType, String>::value && !*(String *) &n->pair (i).second)) {
+                    __destroyPair__ (n->pair (i));
+                    memmove ((void *) &n->pair (i), (void *) &n->pair (i + 1), (n->count - i) * sizeof (Pair));
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+
+                n->count ++;
+                __size__ ++;
+                *pNode = n;
+                *pIndex = i;
+                return err_ok;
+            }
+
+            // erases the pair from the leaf (or replaces it with its predecessor from a leaf) and then fixes the nodes that got too few pairs on the way up
+            template <class K>
+            signed char __erase__ (const K& key) {
+                uint8_t i;
+                __btreeNode__ *n = __find__ (key, &i);
+                if (n == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return err_not_found;
+                }
+
+                __destroyPair__ (n->pair (i));
+                if (n->leaf) {
+                    memmove ((void *) &n->pair (i), (void *) &n->pair (i + 1), (n->count - i - 1) * sizeof (Pair));
+                } else {                                            // move the predecessor (the last pair in the rightmost leaf of the left child) in its place
+                    __btreeNode__ *l = n->child (i);
+                    while (!l->leaf)
+                        l = l->child (l->count);
+                    memcpy ((void *) &n->pair (i), (void *) &l->pair (l->count - 1), sizeof (Pair));
+                    n = l;
+                }
+                n->count --;
+                __size__ --;
+
+                while (n->count < __minPairs__) {
+                    __btreeNode__ *p = n->parent;
+                    if (p == NULL) {                                // the root may have less pairs, but if it is empty the tree gets one level lower
+                        if (n->count == 0) {
+                            __root__ = n->leaf ? NULL : n->child (0);
+                            if (__root__)
+                                __root__->parent = NULL;
+                            __freeNode__ (n);
+                            __height__ --;
+                        }
+                        break;
+                    }
+                    uint8_t j = __childIndex__ (p, n);
+                    if (j > 0 && p->child (j - 1)->count > __minPairs__) {
+                        __borrowFromLeft__ (p, j);
+                        break;
+                    }
+                    if (j < p->count && p->child (j + 1)->count > __minPairs__) {
+                        __borrowFromRight__ (p, j);
+                        break;
+                    }
+                    __merge__ (p, j > 0 ? j - 1 : j);               // neither of the siblings can spare a pair, merge n with one of them
+                    n = p;                                          // p has one pair less now
+                }
+                return err_ok;
+            }
+
+            // child j of p takes the last pair of its left sibling through p
+            static void __borrowFromLeft__ (__btreeNode__ *p, uint8_t j) {
+                __btreeNode__ *n = p->child (j);
+                __btreeNode__ *left = p->child (j - 1);
+                memmove ((void *) &n->pair (1), (void *) &n->pair (0), n->count * sizeof (Pair));
+                memcpy ((void *) &n->pair (0), (void *) &p->pair (j - 1), sizeof (Pair));
+                memcpy ((void *) &p->pair (j - 1), (void *) &left->pair (left->count - 1), sizeof (Pair));
+                if (!n->leaf) {
+                    memmove (&n->child (1), &n->child (0), (n->count + 1) * sizeof (__btreeNode__ *));
+                    n->child (0) = left->child (left->count);
+                    n->child (0)->parent = n;
+                }
+                n->count ++;
+                left->count --;
+            }
+
+            // child j of p takes the first pair of its right sibling through p
+            static void __borrowFromRight__ (__btreeNode__ *p, uint8_t j) {
+                __btreeNode__ *n = p->child (j);
+                __btreeNode__ *right = p->child (j + 1);
+                memcpy ((void *) &n->pair (n->count), (void *) &p->pair (j), sizeof (Pair));
+                memcpy ((void *) &p->pair (j), (void *) &right->pair (0), sizeof (Pair));
+                memmove ((void *) &right->pair (0), (void *) &right->pair (1), (right->count - 1) * sizeof (Pair));
+                if (!n->leaf) {
+                    n->child (n->count + 1) = right->child (0);
+                    n->child (n->count + 1)->parent = n;
+                    memmove (&right->child (0), &right->child (1), right->count * sizeof (__btreeNode__ *));
+                }
+                n->count ++;
+                right->count --;
+            }
+
+            // merges child j + 1 of p and pair j of p into child j
+            void __merge__ (__btreeNode__ *p, uint8_t j) {
+                __btreeNode__ *left = p->child (j);
+                __btreeNode__ *right = p->child (j + 1);
+                memcpy ((void *) &left->pair (left->count), (void *) &p->pair (j), sizeof (Pair));
+                memcpy ((void *) &left->pair (left->count + 1), (void *) &right->pair (0), right->count * sizeof (Pair));
+                if (!left->leaf)
+                    for (uint8_t k = 0; k <= right->count; k++) {
+                        left->child (left->count + 1 + k) = right->child (k);
+                        left->child (left->count + 1 + k)->parent = left;
+                    }
+                left->count += 1 + right->count;
+                memmove ((void *) &p->pair (j), (void *) &p->pair (j + 1), (p->count - j - 1) * sizeof (Pair));
+                memmove (&p->child (j + 1), &p->child (j + 2), (p->count - j - 1) * sizeof (__btreeNode__ *));
+                p->count --;
+                __freeNode__ (right);
+            }
+
+            // the height of B-tree is small (each level multiplies the number of pairs by at least __minPairs__ + 1), so recursion is safe here
+            void __clear__ (__btreeNode__ *n) {
+                if (n == NULL)
+                    return;
+                if (!n->leaf)
+                    for (uint8_t i = 0; i <= n->count; i++)
+                        __clear__ (n->child (i));
+                for (uint8_t i = 0; i < n->count; i++)
+                    __destroyPair__ (n->pair (i));
+                __freeNode__ (n);
+            }
+
+    };
+
+#endif
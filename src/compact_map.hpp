@@ -0,0 +1,618 @@
+/*
+ *  compact_map.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Map with compact nodes, for many pairs of small keys and values. The nodes live in one array and link to each other with 16-bit (or 32-bit)
+ *  indexes into it instead of pointers, there are no parent links, and the AVL balance of each node is packed into the highest bits of its
+ *  two links (a bit per side - set when that side's subtree is higher). So a compact_map<uint16_t, uint16_t> node takes 8 bytes where a
+ *  Map<uint16_t, uint16_t> node takes 3 pointers and 2 heights more than the pair. The interface is the same as the one of Map (a subset).
+ *
+ *  16-bit indexes allow at most 32767 pairs, use uint32_t as the third template parameter for more:
+ *
+ *    compact_map<uint16_t, uint16_t> small;
+ *    compact_map<uint32_t, float, uint32_t> large;
+ *
+ *  The array grows by doubling (with realloc), so the pairs move when it grows: references to values are valid only until the next insertion
+ *  and the keys and values must not point into themselves (Strings are fine). Iterators keep indexes, so they stay valid.
+ *
+ *  compact_map functions are not thread-safe.
+ *
+ *  April 18, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __COMPACT_MAP_HPP__
+    #define __COMPACT_MAP_HPP__
+
+
+    #include "Map.hpp"              // error flags, memory type and key comparison are shared with Map
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want compact_map to throw exceptions (the same setting as for Map)
+
+    #ifndef COMPACT_MAP_MIN_CAPACITY
+        #define COMPACT_MAP_MIN_CAPACITY 4  // number of nodes allocated at first, the array then doubles when it gets full
+    #endif
+
+
+    template <class keyType, class valueType, class indexType = uint16_t, class keyCompare = map_compare> class compact_map {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+            struct Pair {
+                keyType first;          // node key
+                valueType second;       // node value
+            };
+
+            class iterator;             // forward declaration, defined below
+
+
+           /*
+            *  Constructor of compact_map with no pairs:
+            *
+            *    compact_map<uint16_t, uint16_t> cmA;
+            */
+
+            compact_map () {}
+
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+               /*
+                *  Constructor of compact_map from brace enclosed initializer list:
+                *
+                *     compact_map<int, String> cmB = { {1, "one"}, {2, "two"} };
+                */
+
+                compact_map (std::initializer_list<Pair> il) {
+                    for (auto i: il)
+                        if (insert (i.first, i.second))
+                            break;
+                }
+          #endif
+
+                // constructor accepting the array by reference, since AVR boards do not support initializer lists
+                template <int N>
+                compact_map (const Pair (&array) [N]) {
+                    for (int i = 0; i < N; ++i)
+                        if (insert (array [i].first, array [i].second))
+                            break;
+                }
+
+
+           /*
+            *  Copy-constructor and assignment operator copy the other compact_map's pairs.
+            */
+
+            compact_map (compact_map& other) {
+                for (auto& e : other)
+                    if (insert (e.first, e.second))
+                        break;
+                __errorFlags__ |= other.__errorFlags__;
+            }
+
+            compact_map* operator = (compact_map other) {
+                clear ();
+                for (auto& e : other)
+                    if (insert (e.first, e.second))
+                        break;
+                __errorFlags__ |= other.__errorFlags__;
+                return this;
+            }
+
+
+           /*
+            *  compact_map destructor - free the memory occupied by nodes
+            */
+
+            ~compact_map () { clear (); }
+
+
+           /*
+            *  Returns the number of pairs, the height of the tree, and the number of bytes the node array occupies.
+            */
+
+            size_t size () const { return __size__; }
+
+            int height () const {   // follow the higher subtrees, O (log n)
+                int h = 0;
+                for (indexType p = __root__; p != 0; h++)
+                    p = __balance__ (p) > 0 ? __right__ (p) : __left__ (p);
+                return h;
+            }
+
+            size_t bytes () const { return __capacity__ * sizeof (__compactNode__); }
+
+
+           /*
+            *  Returns the number of bytes a pair takes in the node array.
+            */
+
+            static size_t node_size () { return sizeof (__compactNode__); }
+
+
+           /*
+            *  Checks if there are no pairs.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Clears all the pairs and frees the node array.
+            */
+
+            void clear () {
+                for (auto it = begin (); it != end (); ++ it)
+                    (*it).~Pair ();
+                if (__nodes__ != NULL)
+                    free (__nodes__);
+                __nodes__ = NULL;
+                __capacity__ = __used__ = __size__ = 0;
+                __root__ = __freeList__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  [] operator returns the reference to the value of the key, a new pair is inserted if the key is not found:
+            *
+            *    cm [key] = value;
+            */
+
+            template <class K>
+            valueType &operator [] (const K& key) {
+                static valueType dummyValue1 = {};
+                static valueType dummyValue2 = {};
+
+                __path__ path;
+                indexType p = __search__ (key, path);
+                if (p == 0)
+                    p = __emplace__ (path, key, valueType {});
+                if (p != 0)
+                    return __node__ (p).pair.second;
+                dummyValue1 = dummyValue2;
+                return dummyValue1;                 // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
+            }
+
+
+           /*
+            *  Checks if there is a pair with the key and returns the pointer to its value or NULL.
+            */
+
+            template <class K>
+            bool contains (const K& key) const { return __find__ (key) != 0; }
+
+            template <class K>
+            valueType *get_if (const K& key) {
+                indexType p = __find__ (key);
+                return p ? &__node__ (p).pair.second : NULL;
+            }
+
+
+           /*
+            *  Inserts a new pair, returns OK or one of the errors (err_not_unique if the key is already there).
+            */
+
+            signed char insert (const keyType& key, const valueType& value) {
+                __path__ path;
+                if (__search__ (key, path) != 0) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_unique;
+                    #endif
+                    __errorFlags__ |= err_not_unique;
+                    return err_not_unique;
+                }
+                return __emplace__ (path, key, value) ? err_ok : err_bad_alloc;
+            }
+
+
+           /*
+            *  Inserts a new pair or assigns the value to the existing key, returns OK or one of the errors.
+            */
+
+            signed char insert_or_assign (const keyType& key, const valueType& value) {
+                __path__ path;
+                indexType p = __search__ (key, path);
+                if (p == 0)
+                    return __emplace__ (path, key, value) ? err_ok : err_bad_alloc;
+                __node__ (p).pair.second = value;
+                if (is_same<valueType, String>::value && !*(String *) &__node__ (p).pair.second) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                return err_ok;
+            }
+
+
+           /*
+            *  Erases the pair with the key, returns OK or err_not_found.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+                __path__ path;
+                indexType p = __search__ (key, path);
+                if (p == 0) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return err_not_found;
+                }
+
+                int depth = path.depth;
+                if (__left__ (p) != 0 && __right__ (p) != 0) {
+                    // the next node s (the leftmost one in the right subtree) takes the place of p
+                    int pDepth = depth;
+                    path.node [depth] = p;
+                    path.side [depth ++] = 1;
+                    indexType s = __right__ (p);
+                    while (__left__ (s) != 0) {
+                        path.node [depth] = s;
+                        path.side [depth ++] = -1;
+                        s = __left__ (s);
+                    }
+                    __link__ (path.node [depth - 1], path.side [depth - 1], __right__ (s));
+                    __setLeft__ (s, __left__ (p));
+                    __setRight__ (s, __right__ (p));
+                    __setBalance__ (s, __balance__ (p));
+                    __link__ (pDepth > 0 ? path.node [pDepth - 1] : 0, pDepth > 0 ? path.side [pDepth - 1] : 0, s);
+                    path.node [pDepth] = s;
+                } else {
+                    __link__ (depth > 0 ? path.node [depth - 1] : 0, depth > 0 ? path.side [depth - 1] : 0, __left__ (p) != 0 ? __left__ (p) : __right__ (p));
+                }
+                __freeNode__ (p);
+
+                // retrace: the subtree on the side of path.side [k] got lower
+                for (int k = depth - 1; k >= 0; k--) {
+                    indexType x = path.node [k];
+                    int b = __balance__ (x) - path.side [k];
+                    if (b == 1 || b == -1) {                            // it was balanced, its height didn't change
+                        __setBalance__ (x, b);
+                        break;
+                    }
+                    if (b == 0) {                                       // it got balanced and lower
+                        __setBalance__ (x, 0);
+                        continue;
+                    }
+                    bool lower;
+                    indexType r = __rebalance__ (x, b, &lower);
+                    __link__ (k > 0 ? path.node [k - 1] : 0, k > 0 ? path.side [k - 1] : 0, r);
+                    if (!lower)
+                        break;
+                }
+                return err_ok;
+            }
+
+
+           /*
+            *  Iterator visits the pairs in the order of their keys. There are no parent links, so it keeps the path from the root on its own stack.
+            */
+
+            class iterator {
+
+                public:
+
+                    iterator (compact_map *cm) : __cm__ (cm) {}
+
+                    Pair& operator * () { return __cm__->__node__ (__stack__ [__depth__ - 1]).pair; }
+
+                    Pair * operator -> () { return &__cm__->__node__ (__stack__ [__depth__ - 1]).pair; }
+
+                    iterator& operator ++ () {
+                        indexType p = __stack__ [-- __depth__];
+                        __pushLeftmost__ (__cm__->__right__ (p));
+                        return *this;
+                    }
+
+                    bool operator != (const iterator& other) const { return __depth__ != other.__depth__ || (__depth__ > 0 && __stack__ [__depth__ - 1] != other.__stack__ [__depth__ - 1]); }
+
+                    bool operator == (const iterator& other) const { return !(*this != other); }
+
+                private:
+
+                    friend class compact_map;
+
+                    compact_map *__cm__;
+                    indexType __stack__ [sizeof (indexType) * 12];  // AVL trees are less than 1.44 log2 (n) levels high
+                    int __depth__ = 0;
+
+                    void __pushLeftmost__ (indexType p) {
+                        for ( ; p != 0; p = __cm__->__left__ (p))
+                            __stack__ [__depth__ ++] = p;
+                    }
+
+            };
+
+            iterator begin () {
+                iterator it (this);
+                it.__pushLeftmost__ (__root__);
+                return it;
+            }
+
+            iterator end () { return iterator (this); }
+
+
+           /*
+            *  Returns the iterator to the pair with the key or end () if the key is not found.
+            */
+
+            template <class K>
+            iterator find (const K& probe) {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                iterator it (this);
+                indexType p = __root__;
+                while (p != 0) {
+                    int c = keyCompare::compare (key, __node__ (p).pair.first);
+                    if (c == 0) {
+                        it.__stack__ [it.__depth__ ++] = p;
+                        return it;
+                    }
+                    if (c < 0) {                                        // p comes after the key, so it is the next one after its left subtree
+                        it.__stack__ [it.__depth__ ++] = p;
+                        p = __left__ (p);
+                    } else {
+                        p = __right__ (p);
+                    }
+                }
+                return end ();
+            }
+
+
+            #ifdef __OSTREAM_HPP__
+                // print compact_map to ostream
+                friend ostream& operator << (ostream& os, compact_map& m) {
+                    bool first = true;
+                    for (auto& e : m) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << "{" << e.first << "," << e.second << "}";
+                    }
+                    return os;
+                }
+            #endif
+
+
+        private:
+
+            // the highest bit of the left (right) link is set when the left (right) subtree is higher, the other bits are the index + 1 of the child, 0 means no child
+            static const indexType __higher__ = (indexType) ((indexType) 1 << (sizeof (indexType) * 8 - 1));
+            static const indexType __indexMask__ = (indexType) (__higher__ - 1);
+
+            struct __compactNode__ {
+                indexType left;
+                indexType right;
+                Pair pair;
+            };
+
+            __compactNode__ *__nodes__ = NULL;
+            size_t __capacity__ = 0;        // number of nodes in the array
+            size_t __used__ = 0;            // number of nodes that have ever been used, the free ones among them are in the free list
+            size_t __size__ = 0;
+            indexType __root__ = 0;
+            indexType __freeList__ = 0;     // linked through the left links
+
+            // the path from the root to a node: the nodes and the sides (-1 left, 1 right) taken from them
+            struct __path__ {
+                indexType node [sizeof (indexType) * 12];
+                signed char side [sizeof (indexType) * 12];
+                int depth = 0;
+            };
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            __compactNode__& __node__ (indexType i) const { return __nodes__ [i - 1]; }
+
+            indexType __left__ (indexType i) const { return __node__ (i).left & __indexMask__; }
+            indexType __right__ (indexType i) const { return __node__ (i).right & __indexMask__; }
+            void __setLeft__ (indexType i, indexType c) { __node__ (i).left = (__node__ (i).left & __higher__) | c; }
+            void __setRight__ (indexType i, indexType c) { __node__ (i).right = (__node__ (i).right & __higher__) | c; }
+
+            // -1 if the left subtree is higher, 1 if the right one is higher, 0 if they are of the same height
+            int __balance__ (indexType i) const { return (__node__ (i).right & __higher__ ? 1 : 0) - (__node__ (i).left & __higher__ ? 1 : 0); }
+
+            void __setBalance__ (indexType i, int b) {
+                __node__ (i).left = (__node__ (i).left & __indexMask__) | (b < 0 ? __higher__ : 0);
+                __node__ (i).right = (__node__ (i).right & __indexMask__) | (b > 0 ? __higher__ : 0);
+            }
+
+            // links child to the side of parent, or makes it the root if there is no parent
+            void __link__ (indexType parent, int side, indexType child) {
+                if (parent == 0)
+                    __root__ = child;
+                else if (side < 0)
+                    __setLeft__ (parent, child);
+                else
+                    __setRight__ (parent, child);
+            }
+
+            template <class K>
+            indexType __find__ (const K& probe) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                indexType p = __root__;
+                while (p != 0) {
+                    int c = keyCompare::compare (key, __node__ (p).pair.first);
+                    if (c == 0)
+                        return p;
+                    p = c < 0 ? __left__ (p) : __right__ (p);
+                }
+                return 0;
+            }
+
+            // returns the node with the key or 0, the path leads to the node or to where the key belongs
+            template <class K>
+            indexType __search__ (const K& probe, __path__& path) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                indexType p = __root__;
+                while (p != 0) {
+                    int c = keyCompare::compare (key, __node__ (p).pair.first);
+                    if (c == 0)
+                        return p;
+                    path.node [path.depth] = p;
+                    path.side [path.depth ++] = c < 0 ? -1 : 1;
+                    p = c < 0 ? __left__ (p) : __right__ (p);
+                }
+                return 0;
+            }
+
+            // rotates the subtree of x whose balance is 2 or -2, returns its new root and whether the subtree got lower in *lower
+            indexType __rebalance__ (indexType x, int b, bool *lower) {
+                if (b > 0) {
+                    indexType z = __right__ (x);
+                    int bz = __balance__ (z);
+                    if (bz < 0) {                                       // right-left: the left child of z becomes the root
+                        indexType y = __left__ (z);
+                        int by = __balance__ (y);
+                        __setRight__ (x, __left__ (y));
+                        __setLeft__ (z, __right__ (y));
+                        __setLeft__ (y, x);
+                        __setRight__ (y, z);
+                        __setBalance__ (x, by > 0 ? -1 : 0);
+                        __setBalance__ (z, by < 0 ? 1 : 0);
+                        __setBalance__ (y, 0);
+                        *lower = true;
+                        return y;
+                    }
+                    __setRight__ (x, __left__ (z));                     // left rotation
+                    __setLeft__ (z, x);
+                    __setBalance__ (x, bz == 0 ? 1 : 0);
+                    __setBalance__ (z, bz == 0 ? -1 : 0);
+                    *lower = bz != 0;
+                    return z;
+                } else {
+                    indexType z = __left__ (x);
+                    int bz = __balance__ (z);
+                    if (bz > 0) {                                       // left-right: the right child of z becomes the root
+                        indexType y = __right__ (z);
+                        int by = __balance__ (y);
+                        __setLeft__ (x, __right__ (y));
+                        __setRight__ (z, __left__ (y));
+                        __setRight__ (y, x);
+                        __setLeft__ (y, z);
+                        __setBalance__ (x, by < 0 ? 1 : 0);
+                        __setBalance__ (z, by > 0 ? -1 : 0);
+                        __setBalance__ (y, 0);
+                        *lower = true;
+                        return y;
+                    }
+                    __setLeft__ (x, __right__ (z));                     // right rotation
+                    __setRight__ (z, x);
+                    __setBalance__ (x, bz == 0 ? -1 : 0);
+                    __setBalance__ (z, bz == 0 ? 1 : 0);
+                    *lower = bz != 0;
+                    return z;
+                }
+            }
+
+            // takes a node from the free list or from the array, which doubles when it is full, returns 0 if there is not enough memory
+            indexType __allocate__ () {
+                if (__freeList__ != 0) {
+                    indexType i = __freeList__;
+                    __freeList__ = __node__ (i).left;
+                    return i;
+                }
+                if (__used__ == __capacity__) {
+                    if (__capacity__ == __indexMask__)
+                        return 0;                                       // all the indexes are used
+                    size_t capacity = __capacity__ ? 2 * __capacity__ : COMPACT_MAP_MIN_CAPACITY;
+                    if (capacity > __indexMask__)
+                        capacity = __indexMask__;
+                    #if MAP_MEMORY_TYPE == PSRAM_MEM
+                        __compactNode__ *nodes = (__compactNode__ *) ps_realloc ((void *) __nodes__, capacity * sizeof (__compactNode__));
+                    #else
+                        __compactNode__ *nodes = (__compactNode__ *) realloc ((void *) __nodes__, capacity * sizeof (__compactNode__));
+                    #endif
+                    if (nodes == NULL)
+                        return 0;
+                    __nodes__ = nodes;
+                    __capacity__ = capacity;
+                }
+                return (indexType) ++ __used__;
+            }
+
+            void __freeNode__ (indexType i) {
+                __node__ (i).pair.~Pair ();
+                __node__ (i).left = __freeList__;
+                __freeList__ = i;
+                if (-- __size__ == 0) {                                 // release the array together with the last pair
+                    free (__nodes__);
+                    __nodes__ = NULL;
+                    __capacity__ = __used__ = 0;
+                    __root__ = __freeList__ = 0;
+                }
+            }
+
+            // inserts a new pair where the path leads and rebalances the tree, returns the new node or 0 in case of error
+            template <class K>
+            indexType __emplace__ (__path__& path, const K& key, const valueType& value) {
+                indexType n = __allocate__ ();
+                if (n == 0) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return 0;
+                }
+
+                memset ((void *) &__node__ (n), 0, sizeof (__compactNode__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&__node__ (n).pair) Pair { keyType (key), value };
+                #else
+                    __node__ (n).pair.first = key;
+                    __node__ (n).pair.second = value;
+                #endif
+                __size__ ++;
+
+                // in case of Strings - it is possible that key and value didn't get constructed
+                if ((is_same<keyType, String>::value && !*(String *) &__node__ (n).pair.first) || (is_same<valueType, String>::value && !*(String *) &__node__ (n).pair.second)) {
+                    __freeNode__ (n);
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return 0;
+                }
+
+                __link__ (path.depth > 0 ? path.node [path.depth - 1] : 0, path.depth > 0 ? path.side [path.depth - 1] : 0, n);
+
+                // retrace: the subtree on the side of path.side [k] got higher
+                for (int k = path.depth - 1; k >= 0; k--) {
+                    indexType x = path.node [k];
+                    int b = __balance__ (x) + path.side [k];
+                    if (b == 0) {                                       // it got balanced, its height didn't change
+                        __setBalance__ (x, 0);
+                        break;
+                    }
+                    if (b == 1 || b == -1) {                            // it got higher
+                        __setBalance__ (x, b);
+                        continue;
+                    }
+                    bool lower;
+                    indexType r = __rebalance__ (x, b, &lower);
+                    __link__ (k > 0 ? path.node [k - 1] : 0, k > 0 ? path.side [k - 1] : 0, r);
+                    break;                                              // after an insertion the rotation restores the previous height
+                }
+                return n;
+            }
+
+    };
+
+#endif
@@ -0,0 +1,335 @@
+/*
+ *  concurrent_map.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Map that can be used by different tasks at the same time. The keys are spread by their hashes across a number of shards, each shard is
+ *  an ordinary Map with its own reader-writer lock. Tasks that use keys in different shards don't wait for each other at all, and tasks that
+ *  only read the same shard don't wait for each other either, so the tasks no longer serialize on one global mutex.
+ *
+ *  References to the values are never returned, since another task could change or erase the pair while the reference is being used. The
+ *  values are read or changed by find_and_apply and find_and_update instead, which call a function on the value while the shard is locked:
+ *
+ *    concurrent_map<String, int> counters;
+ *    counters.insert ("requests", 0);
+ *    counters.find_and_update ("requests", [] (int& value) { value ++; });
+ *
+ *  The functions should be short, the shard is locked while they run, and they must not use the same concurrent_map again.
+ *
+ *  April 11, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __CONCURRENT_MAP_HPP__
+    #define __CONCURRENT_MAP_HPP__
+
+
+    #include "Map.hpp"              // shards are Maps
+    #include "unordered_map.hpp"    // hash functions are shared with unordered_map
+
+    #ifdef MAP_SHARED_NODE_POOL
+        #error "concurrent_map's shards would share the node pool with all the other Maps of the same node size, which is not thread-safe, please don't use MAP_SHARED_NODE_POOL together with concurrent_map"
+    #endif
+
+    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+        #if __cplusplus >= 201703L
+            #include <shared_mutex>
+        #else
+            #include <mutex>
+            #include <condition_variable>
+        #endif
+    #endif
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    #ifndef CONCURRENT_MAP_SHARDS
+        #define CONCURRENT_MAP_SHARDS 8     // default number of shards, more shards mean less waiting but more memory for locks and empty Maps
+    #endif
+
+
+    // reader-writer lock: many readers or one writer at a time
+    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+        #if __cplusplus >= 201703L
+            typedef std::shared_mutex __readerWriterLock__;
+        #else
+            // older compilers don't have shared_mutex, writers that are waiting stop new readers, so they don't starve
+            class __readerWriterLock__ {
+
+                public:
+
+                    void lock_shared () {
+                        std::unique_lock<std::mutex> l (__mutex__);
+                        while (__writing__ || __waitingWriters__ > 0)
+                            __canRead__.wait (l);
+                        __readers__ ++;
+                    }
+
+                    void unlock_shared () {
+                        std::unique_lock<std::mutex> l (__mutex__);
+                        if (-- __readers__ == 0)
+                            __canWrite__.notify_one ();
+                    }
+
+                    void lock () {
+                        std::unique_lock<std::mutex> l (__mutex__);
+                        __waitingWriters__ ++;
+                        while (__writing__ || __readers__ > 0)
+                            __canWrite__.wait (l);
+                        __waitingWriters__ --;
+                        __writing__ = true;
+                    }
+
+                    void unlock () {
+                        std::unique_lock<std::mutex> l (__mutex__);
+                        __writing__ = false;
+                        __canWrite__.notify_one ();
+                        __canRead__.notify_all ();
+                    }
+
+                private:
+
+                    std::mutex __mutex__;
+                    std::condition_variable __canRead__;
+                    std::condition_variable __canWrite__;
+                    int __readers__ = 0;
+                    int __waitingWriters__ = 0;
+                    bool __writing__ = false;
+
+            };
+        #endif
+    #else
+        // AVR boards don't run tasks
+        struct __readerWriterLock__ {
+            void lock_shared () {}
+            void unlock_shared () {}
+            void lock () {}
+            void unlock () {}
+        };
+    #endif
+
+    // lock guards unlock the shard when they go out of scope, also when Map throws an exception
+    struct __readGuard__ {
+        __readerWriterLock__& lock;
+        __readGuard__ (__readerWriterLock__& l) : lock (l) { lock.lock_shared (); }
+        ~__readGuard__ () { lock.unlock_shared (); }
+    };
+
+    struct __writeGuard__ {
+        __readerWriterLock__& lock;
+        __writeGuard__ (__readerWriterLock__& l) : lock (l) { lock.lock (); }
+        ~__writeGuard__ () { lock.unlock (); }
+    };
+
+
+    template <class keyType, class valueType, size_t shards = CONCURRENT_MAP_SHARDS> class concurrent_map {
+
+        public:
+
+           /*
+            *  Returns the errors of all the shards.
+            */
+
+            signed char errorFlags () const {
+                signed char e = 0;
+                for (size_t i = 0; i < shards; i++) {
+                    __readGuard__ guard (__shards__ [i].lock);
+                    e |= __shards__ [i].map.errorFlags ();
+                }
+                return e;
+            }
+
+            void clearErrorFlags () {
+                for (size_t i = 0; i < shards; i++) {
+                    __writeGuard__ guard (__shards__ [i].lock);
+                    __shards__ [i].map.clearErrorFlags ();
+                }
+            }
+
+
+           /*
+            *  Constructor of concurrent_map with no pairs:
+            *
+            *    concurrent_map<String, String> sessions;
+            *    concurrent_map<int, float, 16> readings;   // 16 shards
+            */
+
+            concurrent_map () {}
+
+            concurrent_map (const concurrent_map&) = delete;
+            concurrent_map& operator = (const concurrent_map&) = delete;
+
+
+           /*
+            *  Returns the number of pairs. The shards are counted one after another, so the result may already be different when it is returned.
+            */
+
+            size_t size () const {
+                size_t n = 0;
+                for (size_t i = 0; i < shards; i++) {
+                    __readGuard__ guard (__shards__ [i].lock);
+                    n += __shards__ [i].map.size ();
+                }
+                return n;
+            }
+
+
+           /*
+            *  Checks if there are no pairs.
+            */
+
+            bool empty () const { return size () == 0; }
+
+
+           /*
+            *  Inserts a new pair, returns OK or one of the errors.
+            */
+
+            signed char insert (const keyType& key, const valueType& value) {
+                __shard__& s = __shardOf__ (key);
+                __writeGuard__ guard (s.lock);
+                return s.map.insert (key, value);
+            }
+
+
+           /*
+            *  Inserts a new pair or assigns the value to the existing key, returns OK or one of the errors.
+            */
+
+            signed char insert_or_assign (const keyType& key, const valueType& value) {
+                __shard__& s = __shardOf__ (key);
+                __writeGuard__ guard (s.lock);
+                return s.map.insert_or_assign (key, value);
+            }
+
+
+           /*
+            *  Erases the pair with the key, returns OK or one of the errors.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+                __shard__& s = __shardOf__ (key);
+                __writeGuard__ guard (s.lock);
+                return s.map.erase (key);
+            }
+
+
+           /*
+            *  Checks if the key is in concurrent_map.
+            */
+
+            template <class K>
+            bool contains (const K& key) const {
+                __shard__& s = __shardOf__ (key);
+                __readGuard__ guard (s.lock);
+                return s.map.contains (key);
+            }
+
+
+           /*
+            *  Copies the value of the key into value, returns false if the key is not found.
+            */
+
+            template <class K>
+            bool get (const K& key, valueType& value) const {
+                __shard__& s = __shardOf__ (key);
+                __readGuard__ guard (s.lock);
+                auto it = s.map.find (key);
+                if (it == s.map.end ())
+                    return false;
+                value = it->second;
+                return true;
+            }
+
+
+           /*
+            *  Calls function (const valueType& value) while the shard is locked for reading, other readers of the shard may run at the same time.
+            *  Returns false if the key is not found:
+            *
+            *    float sum = 0;
+            *    readings.find_and_apply (sensor, [&sum] (const float& value) { sum += value; });
+            */
+
+            template <class K, class F>
+            bool find_and_apply (const K& key, F function) const {
+                __shard__& s = __shardOf__ (key);
+                __readGuard__ guard (s.lock);
+                auto it = s.map.find (key);
+                if (it == s.map.end ())
+                    return false;
+                function ((const valueType&) it->second);
+                return true;
+            }
+
+
+           /*
+            *  Calls function (valueType& value) while the shard is locked for writing, so the function may change the value.
+            *  Returns false if the key is not found.
+            */
+
+            template <class K, class F>
+            bool find_and_update (const K& key, F function) {
+                __shard__& s = __shardOf__ (key);
+                __writeGuard__ guard (s.lock);
+                auto it = s.map.find (key);
+                if (it == s.map.end ())
+                    return false;
+                function (it->second);
+                return true;
+            }
+
+
+           /*
+            *  Calls function (const keyType& key, const valueType& value) for all the pairs, one shard at a time, returns the number of calls.
+            *  The pairs are ordered within a shard only.
+            */
+
+            template <class F>
+            size_t for_each (F function) const {
+                size_t count = 0;
+                for (size_t i = 0; i < shards; i++) {
+                    __readGuard__ guard (__shards__ [i].lock);
+                    for (auto& e : __shards__ [i].map) {
+                        function ((const keyType&) e.first, (const valueType&) e.second);
+                        count ++;
+                    }
+                }
+                return count;
+            }
+
+
+           /*
+            *  Erases all the pairs.
+            */
+
+            void clear () {
+                for (size_t i = 0; i < shards; i++) {
+                    __writeGuard__ guard (__shards__ [i].lock);
+                    __shards__ [i].map.clear ();
+                }
+            }
+
+
+        private:
+
+            // each shard on its own cache line, so that the tasks locking different shards don't slow each other down
+            struct
+            #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                alignas (64)
+            #endif
+            __shard__ {
+                __readerWriterLock__ lock;
+                Map<keyType, valueType> map;
+            };
+
+            mutable __shard__ __shards__ [shards];
+
+            // numbers are converted to keyType first, so they are hashed into the same shard as the keys they find: insert (5L, ...) and contains (5)
+            template <class K>
+            __shard__& __shardOf__ (const K& key) const { return __shards__ [__unorderedMapHash__ (__mapProbe__<keyType, K>::key (key)) % shards]; }
+
+    };
+
+#endif
@@ -0,0 +1,536 @@
+/*
+ *  dlist.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Double - linked list. Each element needs one pointer more than in a single - linked list, but in return it can be added or removed at both
+ *  ends, erased through iterator without searching for the previous element, iterated in both directions and moved around with splice,
+ *  all in O(1) time. This makes it suitable for LRU and undo buffers.
+ *
+ *  February 6, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __DLIST_HPP__
+    #define __DLIST_HPP__
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define THROW_LIST_EXCEPTIONS  // uncomment this line if you want list to throw exceptions
+
+
+    // error flags: there is only one type of error flags that can be set: err_bad_alloc - please note that all errors are negative (char) numbers
+    #define err_ok           ((signed char) 0b00000000) //    0 - no error
+    #define err_bad_alloc    ((signed char) 0b10000001) // -127 - out of memory
+    #define err_out_of_range ((signed char) 0b10000010) // -126 - invalid addressing of list element
+
+
+    // type of memory used (the same setting as for single - linked lists)
+    #define HEAP_MEM 2
+    #define PSRAM_MEM 3
+    #ifndef LIST_MEMORY_TYPE
+        #define LIST_MEMORY_TYPE HEAP_MEM // use heap by default
+    #endif
+
+
+    template <class listType> class dlist {
+
+        private:
+
+            signed char __errorFlags__ = 0;
+
+            struct node_t {
+                listType element;
+                node_t *prev;
+                node_t *next;
+            };
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+
+           /*
+            *  Constructor of dlist with no elements allows the following kinds of creation of lists:
+            *
+            *    dlist<int> A;
+            */
+
+            dlist () {}
+
+
+            #ifndef ARDUINO_ARCH_AVR
+                   /*
+                    *  Constructor of dlist from brace enclosed initializer list allows the following kinds of creation of list:
+                    *
+                    *     dlist<int> D = { 200, 300, 400 };
+                    *     dlist<int> E ( { 500, 600 } );
+                    */
+
+                    dlist (const std::initializer_list<listType>& il) {
+                        for (auto element: il)
+                            if (push_back (element)) // error
+                                break;
+                    }
+            #endif
+                // constructor accepting the array by reference, since AVR boards do not support initializer lists
+                template <int N>
+                dlist (const listType (&array) [N]) {
+                    for (int i = 0; i < N; ++i)
+                        if (push_back (array [i])) // error
+                            break;
+                }
+
+
+           /*
+            * List destructor - free the memory occupied by list elements
+            */
+
+            ~dlist () {
+                clear ();
+            }
+
+
+           /*
+            * Returns the number of elements in the list.
+            */
+
+            int size () { return __size__; }
+
+
+           /*
+            * Checks if list is empty.
+            */
+
+            bool empty () { return __size__ == 0; }
+
+
+           /*
+            * Clears all the elements from the list.
+            */
+
+            void clear () {
+                node_t *p = __front__;
+                while (p) {
+                    node_t *q = p->next;
+                    __freeNode__ (p);
+                    p = q;
+                }
+                __front__ = __back__ = NULL;
+                __size__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  Copy-constructor of dlist allows the following kinds of creation of list:
+            *
+            *     dlist<int> F = E;
+            *
+            *  Calling program should check errorFlags () after constructor is beeing called for possible errors
+            */
+
+            dlist (dlist& other) {
+                for (auto element: other)
+                    if (this->push_back (element)) // error
+                        break;
+            }
+
+
+           /*
+            *  Assignment operator of dlist allows the following kinds of assignements of list:
+            *
+            *     dlist<int> F;
+            *     F = { 1, 2, 3 }; or F = {};
+            */
+
+            dlist* operator = (const dlist& other) {
+                if (this == &other)
+                    return this;
+                this->clear (); // clear existing elements if needed
+
+                for (node_t *p = other.__front__; p; p = p->next)
+                    if (this->push_back (p->element)) // error
+                        break;
+                return this;
+            }
+
+
+           /*
+            *  Adds element to the end or to the beginning of a list, like:
+            *
+            *    E.push_back (700);
+            *    E.push_front (400);
+            *
+            *  Returns OK or one of the error flags in case of error:
+            *    - could not allocate enough memory for requested storage
+            */
+
+            signed char push_back (const listType& element) { return __insert__ (NULL, element) ? err_ok : err_bad_alloc; }
+
+            signed char push_front (const listType& element) { return __insert__ (__front__, element) ? err_ok : err_bad_alloc; }
+
+
+           /*
+            *  Constructs element in place at the end or at the beginning of a list, like:
+            *
+            *    E.emplace_back (700);
+            *
+            *  Returns OK or one of the error flags in case of error (the same as push_back).
+            */
+
+            template <typename... Args>
+            signed char emplace_back (Args&&... args) { return __insert__ (NULL, static_cast<Args&&> (args)...) ? err_ok : err_bad_alloc; }
+
+            template <typename... Args>
+            signed char emplace_front (Args&&... args) { return __insert__ (__front__, static_cast<Args&&> (args)...) ? err_ok : err_bad_alloc; }
+
+
+           /*
+            * Removes the first or the last element from the list in O(1) time.
+            */
+
+            signed char pop_front () {
+                if (__front__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __freeNode__ (__unlink__ (__front__));
+                return err_ok;
+            }
+
+            signed char pop_back () {
+                if (__back__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __freeNode__ (__unlink__ (__back__));
+                return err_ok;
+            }
+
+
+           /*
+            * Returns the reference to the first element of the list.
+            */
+
+            listType& front () {
+                if (__front__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    static listType ev = {};
+                    return ev;
+                }
+                return __front__->element;
+            }
+
+
+           /*
+            * Returns the reference to the last element of the list.
+            */
+
+            listType& back () {
+                if (__back__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    static listType ev = {};
+                    return ev;
+                }
+                return __back__->element;
+            }
+
+
+           /*
+            * Deletes all the occurrences of an element
+            */
+
+        private:
+
+            template<typename T1, typename T2> inline __attribute__((always_inline)) bool __equals__ (const T1& a, const T2& b);
+
+        public:
+
+            void remove (const listType& element) {
+                node_t *p = __front__;
+                while (p) {
+                    node_t *q = p->next;
+                    if (__equals__ (p->element, element))
+                        __freeNode__ (__unlink__ (p));
+                    p = q;
+                }
+            }
+
+
+           /*
+            *  Bidirectional iterator. Example:
+            *
+            *    for (auto element: A)
+            *      Serial.println (element);
+            *
+            *    auto it = A.end ();
+            *    while (it != A.begin ())
+            *      Serial.println (*-- it);
+            */
+
+            class iterator {
+
+                friend dlist;
+
+                public:
+
+                    // constructor
+                    iterator (dlist *l, node_t *p) { __l__ = l; __p__ = p; }
+
+                    // * operator
+                    listType& operator *() const { return __p__->element; }
+
+                    // -> operator
+                    listType* operator -> () const { return &__p__->element; }
+
+                    // ++ (prefix) increment
+                    iterator& operator ++ () { __p__ = __p__->next; return *this; }
+
+                    // -- (prefix) decrement, -- end () points to the last element
+                    iterator& operator -- () { __p__ = __p__ ? __p__->prev : __l__->__back__; return *this; }
+
+                    // C++ will stop iterating when != operator returns false
+                    friend bool operator != (const iterator& a, const iterator& b) { return a.__p__ != b.__p__; }
+                    friend bool operator == (const iterator& a, const iterator& b) { return a.__p__ == b.__p__; }
+
+                    // this will tell if iterator is valid (if there are not elements the iterator can not be valid)
+                    operator bool () const { return __p__ != NULL; }
+
+                private:
+
+                    dlist *__l__ = NULL;
+                    node_t *__p__ = NULL;
+
+            };
+
+            iterator begin () { return iterator (this, __front__); }        // first element
+            iterator end () { return iterator (this, NULL); }               // past the last element
+
+
+           /*
+            *  Reverse iterator iterates from the last element towards the first one. Example:
+            *
+            *    for (auto it = A.rbegin (); it != A.rend (); ++ it)
+            *      Serial.println (*it);
+            */
+
+            class reverse_iterator {
+
+                friend dlist;
+
+                public:
+
+                    // constructor
+                    reverse_iterator (dlist *l, node_t *p) { __l__ = l; __p__ = p; }
+
+                    // * operator
+                    listType& operator *() const { return __p__->element; }
+
+                    // -> operator
+                    listType* operator -> () const { return &__p__->element; }
+
+                    // ++ (prefix) increment moves towards the front of the list
+                    reverse_iterator& operator ++ () { __p__ = __p__->prev; return *this; }
+
+                    // -- (prefix) decrement moves towards the back of the list, -- rend () points to the first element
+                    reverse_iterator& operator -- () { __p__ = __p__ ? __p__->next : __l__->__front__; return *this; }
+
+                    // C++ will stop iterating when != operator returns false
+                    friend bool operator != (const reverse_iterator& a, const reverse_iterator& b) { return a.__p__ != b.__p__; }
+                    friend bool operator == (const reverse_iterator& a, const reverse_iterator& b) { return a.__p__ == b.__p__; }
+
+                    // this will tell if iterator is valid
+                    operator bool () const { return __p__ != NULL; }
+
+                    // returns (forward) iterator pointing to the same element, so it can be used with erase, insert or splice
+                    iterator base () const { return iterator (__l__, __p__); }
+
+                private:
+
+                    dlist *__l__ = NULL;
+                    node_t *__p__ = NULL;
+
+            };
+
+            reverse_iterator rbegin () { return reverse_iterator (this, __back__); }    // last element
+            reverse_iterator rend () { return reverse_iterator (this, NULL); }          // before the first element
+
+
+           /*
+            *  Inserts element in front of the element pointed to by iterator (or at the end if iterator equals end ()), like:
+            *
+            *    E.insert (E.begin (), 500);
+            *
+            *  Returns the iterator pointing to the inserted element or end () in case of error:
+            *    - could not allocate enough memory for requested storage
+            */
+
+            iterator insert (iterator pos, const listType& element) { return iterator (this, __insert__ (pos.__p__, element)); }
+
+            template <typename... Args>
+            iterator emplace (iterator pos, Args&&... args) { return iterator (this, __insert__ (pos.__p__, static_cast<Args&&> (args)...)); }
+
+
+           /*
+            *  Deletes the element pointed to by iterator in O(1) time (no searching is needed).
+            *
+            *  Returns the iterator pointing to the element following the deleted one.
+            */
+
+            iterator erase (iterator pos) {
+                if (!pos.__p__) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+                node_t *next = pos.__p__->next;
+                __freeNode__ (__unlink__ (pos.__p__));
+                return iterator (this, next);
+            }
+
+
+           /*
+            *  Moves elements from other list (or from the same list) in front of the element pointed to by pos. Nodes are only relinked,
+            *  so nothing gets allocated, copied or freed and this always succeeds in O(1) time:
+            *
+            *    A.splice (A.end (), B);                // move all the elements of B to the end of A
+            *    A.splice (A.begin (), A, it);          // move element pointed to by it to the front of A (LRU)
+            */
+
+            void splice (iterator pos, dlist& other) {
+                if (&other == this || other.__front__ == NULL)
+                    return;
+
+                node_t *first = other.__front__;
+                node_t *last = other.__back__;
+                int n = other.__size__;
+                other.__front__ = other.__back__ = NULL;
+                other.__size__ = 0;
+
+                node_t *next = pos.__p__;
+                node_t *prev = next ? next->prev : __back__;
+                first->prev = prev;
+                last->next = next;
+                if (prev) prev->next = first; else __front__ = first;
+                if (next) next->prev = last; else __back__ = last;
+                __size__ += n;
+            }
+
+            void splice (iterator pos, dlist& other, iterator it) {
+                if (!it.__p__ || it.__p__ == pos.__p__ || (pos.__p__ && it.__p__->next == pos.__p__ && &other == this))
+                    return; // nothing to move
+                other.__unlink__ (it.__p__);
+                __link__ (pos.__p__, it.__p__);
+            }
+
+
+            #ifdef __OSTREAM_HPP__
+                // print list to ostream
+                friend ostream& operator << (ostream& os, dlist& l) {
+                    os << "(front)🡘";
+                    for (auto e : l)
+                        os << e << "🡘";
+                    os << "(back)";
+                    return os;
+                }
+            #endif
+
+
+      private:
+
+            node_t *__front__ = NULL;         // points to the first list node, initially the list has no elements
+            node_t *__back__ = NULL;          // points to the last list node, initially the list has no elements
+            int __size__ = 0;                 // initially there are not elements in the list
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            // allocates a new node, constructs the element from arguments and links it in front of node next (or at the end if next is NULL), returns NULL in case of error
+            template <typename... Args>
+            node_t *__insert__ (node_t *next, Args&&... args) {
+                // allocate new memory for element
+                #if LIST_MEMORY_TYPE == PSRAM_MEM
+                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
+                #else // use heap
+                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
+                #endif
+                if (newNode == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return NULL;
+                }
+
+                memset (newNode, 0, sizeof (node_t));
+                #ifndef ARDUINO_ARCH_AVR
+                    new (&newNode->element) listType (static_cast<Args&&> (args)...); // construct the element directly in the node
+                #else
+                    newNode->element = listType (args...);  // objects not supported for AVR boards
+                #endif
+
+                if (is_same<listType, String>::value)          // if element is of type String ...
+                    if (!*(String *) &newNode->element) {       // ... check if construction is valid
+                        __freeNode__ (newNode);
+                        #ifdef THROW_LIST_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;       // report error if it is not
+                        return NULL;
+                    }
+
+                __link__ (next, newNode);
+                return newNode;
+            }
+
+            // links node n in front of node next (or at the end if next is NULL)
+            void __link__ (node_t *next, node_t *n) {
+                node_t *prev = next ? next->prev : __back__;
+                n->prev = prev;
+                n->next = next;
+                if (prev) prev->next = n; else __front__ = n;
+                if (next) next->prev = n; else __back__ = n;
+                __size__ ++;
+            }
+
+            // unlinks node n from the list but doesn't free it
+            node_t *__unlink__ (node_t *n) {
+                if (n->prev) n->prev->next = n->next; else __front__ = n->next;
+                if (n->next) n->next->prev = n->prev; else __back__ = n->prev;
+                __size__ --;
+                return n;
+            }
+
+            // destructs the element and frees the node
+            void __freeNode__ (node_t *n) {
+                n->~node_t ();
+                free (n);
+            }
+
+    };
+
+    template<typename listType> template<typename T1, typename T2> __attribute__((always_inline)) bool dlist<listType>::__equals__ (const T1& a, const T2& b) { return a == b; }
+    template<> template<> inline __attribute__((always_inline)) bool dlist<const char*>::__equals__ (const char* const& a, const char* const& b) { return strcmp (a, b) == 0; }
+    template<> template<> inline __attribute__((always_inline)) bool dlist<char*>::__equals__ (char* const& a, char* const& b) { return strcmp (a, b) == 0; }
+
+#endif
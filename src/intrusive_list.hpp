@@ -0,0 +1,432 @@
+/*
+ *  intrusive_list.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Intrusive list doesn't allocate any memory. Instead of copying elements into its own nodes, it links the objects themselves through an
+ *  intrusive_list_hook member that the object embeds, for example:
+ *
+ *    struct connection_t {
+ *        int socket;
+ *        intrusive_list_hook hook;   // this is where the links are stored
+ *    };
+ *
+ *    connection_t connections [8];   // static storage
+ *    intrusive_list<connection_t, &connection_t::hook> activeConnections;
+ *
+ *  Linking and unlinking only change a few pointers in O(1) time and they can never fail for lack of memory, so they can be used from
+ *  interrupt service routines. Please note that the list itself is not protected against concurrent access - if the same list is used
+ *  both from ISR and from loop, the loop side must disable interrupts while it is using the list.
+ *
+ *  The object must stay at the same memory location while it is linked and it can only be linked into one list through one hook. If
+ *  the object should be a member of more lists at the same time it needs more hooks.
+ *
+ *  February 6, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __INTRUSIVE_LIST_HPP__
+    #define __INTRUSIVE_LIST_HPP__
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define THROW_LIST_EXCEPTIONS  // uncomment this line if you want list to throw exceptions
+
+
+    // error flags - please note that all errors are negative (char) numbers
+    #define err_ok           ((signed char) 0b00000000) //    0 - no error
+    #define err_out_of_range ((signed char) 0b10000010) // -126 - invalid addressing of list element
+    #define err_not_unique   ((signed char) 0b10001000) // -120 - element is already linked into a list
+
+
+   /*
+    *  The links that the object embeds. Unlinked hook has all the pointers set to NULL, linked hook also remembers the list it is linked into,
+    *  so that a list doesn't unlink objects that belong to some other list.
+    *
+    *  The links belong to the object's place in the list, not to its content, so copying an object never copies them: the copy starts
+    *  unlinked and an assigned object stays linked wherever it was.
+    */
+
+    struct intrusive_list_hook {
+        intrusive_list_hook *prev = NULL;
+        intrusive_list_hook *next = NULL;
+        const void *list = NULL;
+
+        intrusive_list_hook () {}
+        intrusive_list_hook (const intrusive_list_hook&) {}
+        intrusive_list_hook& operator = (const intrusive_list_hook&) { return *this; }
+
+        bool is_linked () const { return next != NULL; }
+    };
+
+
+    template <class T, intrusive_list_hook T::*hook> class intrusive_list_iterator;
+
+    template <class T, intrusive_list_hook T::*hook> class intrusive_list {
+
+        friend class intrusive_list_iterator<T, hook>;
+
+        private:
+
+            signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+            typedef intrusive_list_iterator<T, hook> iterator;
+
+
+           /*
+            *  Constructor of empty intrusive list:
+            *
+            *    intrusive_list<connection_t, &connection_t::hook> activeConnections;
+            */
+
+            intrusive_list () { __head__.prev = __head__.next = &__head__; }
+
+
+           /*
+            *  Intrusive list doesn't own its elements so it can not be copied. The destructor only unlinks the elements that are still linked.
+            */
+
+            intrusive_list (const intrusive_list&) = delete;
+            intrusive_list& operator = (const intrusive_list&) = delete;
+
+            ~intrusive_list () { clear (); }
+
+
+           /*
+            * Returns the number of elements in the list.
+            */
+
+            int size () { return __size__; }
+
+
+           /*
+            * Checks if list is empty.
+            */
+
+            bool empty () { return __size__ == 0; }
+
+
+           /*
+            * Unlinks all the elements from the list (the objects themselves are not affected).
+            */
+
+            void clear () {
+                intrusive_list_hook *p = __head__.next;
+                while (p != &__head__) {
+                    intrusive_list_hook *q = p->next;
+                    p->prev = p->next = NULL;
+                    p->list = NULL;
+                    p = q;
+                }
+                __head__.prev = __head__.next = &__head__;
+                __size__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  Links the object to the end or to the beginning of a list, like:
+            *
+            *    activeConnections.push_back (connections [3]);
+            *
+            *  Returns OK or one of the error flags in case of error:
+            *    - the object is already linked (into this or some other list)
+            */
+
+            signed char push_back (T& element) { return __link__ (&__head__, &(element.*hook)); }
+
+            signed char push_front (T& element) { return __link__ (__head__.next, &(element.*hook)); }
+
+
+           /*
+            *  Links the object in front of the element pointed to by iterator (or at the end if iterator equals end ()).
+            *
+            *  Returns OK or one of the error flags in case of error:
+            *    - the object is already linked (into this or some other list)
+            *    - the iterator belongs to some other list
+            */
+
+            signed char insert (iterator pos, T& element) {
+                if (pos.__h__ != &__head__ && pos.__h__->list != this) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                return __link__ (pos.__h__, &(element.*hook));
+            }
+
+
+           /*
+            * Unlinks the first or the last object from the list.
+            */
+
+            signed char pop_front () {
+                if (__size__ == 0) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __unlink__ (__head__.next);
+                return err_ok;
+            }
+
+            signed char pop_back () {
+                if (__size__ == 0) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __unlink__ (__head__.prev);
+                return err_ok;
+            }
+
+
+           /*
+            *  Returns the reference to the first or the last object in the list. Calling program should check if the list is empty first,
+            *  since there is no object to return if it is (a reference to a dummy object is returned then).
+            */
+
+            T& front () {
+                if (__size__ == 0) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    static T ev = {};
+                    return ev;
+                }
+                return *__owner__ (__head__.next);
+            }
+
+            T& back () {
+                if (__size__ == 0) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    static T ev = {};
+                    return ev;
+                }
+                return *__owner__ (__head__.prev);
+            }
+
+
+           /*
+            *  Unlinks the object from the list in O(1) time, no searching is needed:
+            *
+            *    activeConnections.remove (connections [3]);
+            *
+            *  Returns OK or err_out_of_range if the object is not linked into this list.
+            */
+
+            signed char remove (T& element) {
+                intrusive_list_hook *h = &(element.*hook);
+                if (h->list != this) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __unlink__ (h);
+                return err_ok;
+            }
+
+
+           /*
+            *  Unlinks the object pointed to by iterator and returns the iterator pointing to the following one. The iterator must point to
+            *  an object of this list, end () or an iterator of some other list are rejected with err_out_of_range.
+            */
+
+            iterator erase (iterator pos) {
+                if (pos.__h__->list != this) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+                intrusive_list_hook *next = pos.__h__->next;
+                __unlink__ (pos.__h__);
+                return iterator (next);
+            }
+
+
+           /*
+            *  Bidirectional iterator that can be used with find, min_element, max_element and sort from algorithm.hpp. Example:
+            *
+            *    for (auto& c: activeConnections)
+            *      Serial.println (c.socket);
+            */
+
+            iterator begin () { return iterator (__head__.next); }    // first element
+            iterator end () { return iterator (&__head__); }          // past the last element
+
+            // returns the iterator pointing to the object that is already linked into this list
+            iterator iterator_to (T& element) { return iterator (&(element.*hook)); }
+
+
+           /*
+            *  Sorts the list (or its part between iterators) by relinking the objects, so nothing gets copied. Merge sort is stable and
+            *  takes O(n log n) time. Elements are compared with < operator unless a comparison function is given:
+            *
+            *    activeConnections.sort ();
+            *    activeConnections.sort ([] (const connection_t& a, const connection_t& b) { return a.socket > b.socket; });
+            */
+
+            void sort () { __sort__ (begin (), end (), [] (const T& a, const T& b) { return a < b; }); }
+
+            template <typename Compare>
+            void sort (Compare smaller) { __sort__ (begin (), end (), smaller); }
+
+            template <typename Compare>
+            static void __sort__ (iterator first, iterator last, Compare smaller) {
+                if (first.__h__ == last.__h__ || first.__h__->next == last.__h__)
+                    return; // less than 2 elements, nothing to sort
+
+                intrusive_list_hook *before = first.__h__->prev;
+                intrusive_list_hook *after = last.__h__;
+                after->prev->next = NULL; // terminate the chain so it can be sorted as a single linked list
+
+                // bottom-up merge sort: bin [i] holds an already sorted chain of 2^i elements, like counting in binary
+                intrusive_list_hook *bin [32] = {};
+                intrusive_list_hook *p = first.__h__;
+                while (p) {
+                    intrusive_list_hook *carry = p;
+                    p = p->next;
+                    carry->next = NULL;
+                    int i = 0;
+                    for (; i < 31 && bin [i]; i ++) {
+                        carry = __merge__ (bin [i], carry, smaller); // bin [i] holds earlier elements, so merging stays stable
+                        bin [i] = NULL;
+                    }
+                    if (bin [i])
+                        carry = __merge__ (bin [i], carry, smaller);
+                    bin [i] = carry;
+                }
+                intrusive_list_hook *sorted = NULL;
+                for (int i = 0; i < 32; i ++)
+                    if (bin [i])
+                        sorted = __merge__ (bin [i], sorted, smaller);
+
+                // put the sorted chain back between before and after and correct the prev pointers
+                for (p = sorted; p; p = p->next) {
+                    before->next = p;
+                    p->prev = before;
+                    before = p;
+                }
+                before->next = after;
+                after->prev = before;
+            }
+
+
+      private:
+
+            intrusive_list_hook __head__;     // sentinel: __head__.next points to the first hook and __head__.prev to the last one, the list is circular
+            int __size__ = 0;                 // initially there are not elements in the list
+
+            // calculates the address of the object from the address of its hook member
+            static T *__owner__ (intrusive_list_hook *h) {
+                T *dummy = reinterpret_cast<T *> (sizeof (T)); // any non-NULL address would do, the object is never accessed
+                return reinterpret_cast<T *> (reinterpret_cast<char *> (h) - (reinterpret_cast<char *> (&(dummy->*hook)) - reinterpret_cast<char *> (dummy)));
+            }
+
+            // links hook h in front of hook next
+            signed char __link__ (intrusive_list_hook *next, intrusive_list_hook *h) {
+                if (h->is_linked ()) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_not_unique;
+                    #endif
+                    __errorFlags__ |= err_not_unique;
+                    return err_not_unique;
+                }
+                h->prev = next->prev;
+                h->next = next;
+                h->list = this;
+                next->prev->next = h;
+                next->prev = h;
+                __size__ ++;
+                return err_ok;
+            }
+
+            // unlinks hook h
+            void __unlink__ (intrusive_list_hook *h) {
+                h->prev->next = h->next;
+                h->next->prev = h->prev;
+                h->prev = h->next = NULL;
+                h->list = NULL;
+                __size__ --;
+            }
+
+            // merges two sorted NULL terminated chains, elements of a go first when equal
+            template <typename Compare>
+            static intrusive_list_hook *__merge__ (intrusive_list_hook *a, intrusive_list_hook *b, Compare& smaller) {
+                intrusive_list_hook head;
+                intrusive_list_hook *tail = &head;
+                while (a && b) {
+                    if (smaller (*__owner__ (b), *__owner__ (a))) {
+                        tail->next = b;
+                        b = b->next;
+                    } else {
+                        tail->next = a;
+                        a = a->next;
+                    }
+                    tail = tail->next;
+                }
+                tail->next = a ? a : b;
+                return head.next;
+            }
+
+    };
+
+
+   /*
+    *  Iterator is declared outside of the intrusive_list class so that algorithm.hpp's sort can recognize it.
+    */
+
+    template <class T, intrusive_list_hook T::*hook> class intrusive_list_iterator {
+
+        friend class intrusive_list<T, hook>;
+
+        public:
+
+            // constructor
+            intrusive_list_iterator (intrusive_list_hook *h) { __h__ = h; }
+
+            // * operator
+            T& operator *() const { return *intrusive_list<T, hook>::__owner__ (__h__); }
+
+            // -> operator
+            T* operator -> () const { return intrusive_list<T, hook>::__owner__ (__h__); }
+
+            // ++ (prefix) increment
+            intrusive_list_iterator& operator ++ () { __h__ = __h__->next; return *this; }
+
+            // -- (prefix) decrement
+            intrusive_list_iterator& operator -- () { __h__ = __h__->prev; return *this; }
+
+            // C++ will stop iterating when != operator returns false
+            friend bool operator != (const intrusive_list_iterator& a, const intrusive_list_iterator& b) { return a.__h__ != b.__h__; }
+            friend bool operator == (const intrusive_list_iterator& a, const intrusive_list_iterator& b) { return a.__h__ == b.__h__; }
+
+        private:
+
+            intrusive_list_hook *__h__ = NULL;
+
+    };
+
+#endif
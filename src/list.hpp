@@ -75,7 +75,7 @@
                     */
             
                     list (const std::initializer_list<listType>& il) {
-                        for (auto element: il)
+                        for (const auto& element: il)
                             if (push_back (element)) // error
                                 break;
                     }
@@ -141,6 +141,7 @@
                     p = q;
                 }
                 __front__ = NULL;
+                __back__ = NULL;
                 __size__ = 0;
                 clearErrorFlags ();
             } 
@@ -158,7 +159,7 @@
       
             list (list& other) {
                 // copy other's elements
-                for (auto element: other)
+                for (const auto& element: other)
                     if (this->push_back (element)) // error
                         break;
             }
@@ -189,42 +190,15 @@
             *  
             *    E.push_back (700);
             *    
+            *  The element is copy-constructed directly in the new node, or move-constructed if it is a temporary object.
+            *
             *  Returns OK or one of the error flags in case of error:
             *    - could not allocate enough memory for requested storage
             */
     
-            signed char push_back (const listType& element) {
-                // allocate new memory for element
-                #if LIST_MEMORY_TYPE == PSRAM_MEM
-                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
-                #else // use heap
-                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
-                #endif
-                if (newNode == NULL) {
-                    #ifdef THROW_LIST_EXCEPTIONS
-                        throw err_bad_alloc;
-                    #endif
-                    __errorFlags__ |= err_bad_alloc;
-                    return err_bad_alloc;
-                }
-
-                memset (newNode, 0, sizeof (node_t));
-                #ifndef ARDUINO_ARCH_AVR 
-                    new (newNode) node_t; 
-                #endif
+            signed char push_back (const listType& element) { return emplace_back (element); }
 
-                // add the new element to the end
-                newNode->element = element;
-                newNode->next = NULL;
-                if (__front__ == NULL)
-                    __front__ = newNode;
-                if (__back__ != NULL)
-                    __back__->next = newNode;
-                __back__ = newNode;
-                
-                __size__ ++;
-                return err_ok;
-            }
+            signed char push_back (listType&& element) { return emplace_back (static_cast<listType&&> (element)); }
 
 
            /*
@@ -236,35 +210,39 @@
             *    - could not allocate enough memory for requested storage
             */
               
-            signed char push_front (const listType& element) {
-                // allocate new memory for element
-                #if LIST_MEMORY_TYPE == PSRAM_MEM
-                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
-                #else // use heap
-                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
-                #endif
-                if (newNode == NULL) {
-                    #ifdef THROW_LIST_EXCEPTIONS
-                        throw err_bad_alloc;
-                    #endif
-                    __errorFlags__ |= err_bad_alloc;
-                    return err_bad_alloc;
-                }
+            signed char push_front (const listType& element) { return emplace_front (element); }
 
-                memset (newNode, 0, sizeof (node_t));
-                #ifndef ARDUINO_ARCH_AVR 
-                    new (newNode) node_t; 
-                #endif
+            signed char push_front (listType&& element) { return emplace_front (static_cast<listType&&> (element)); }
 
-                // add the new element to the beginning
-                newNode->element = element;
-                newNode->next = __front__;
-                __front__ = newNode;
-                if (__back__ == NULL)
-                    __back__ = newNode;
-                
-                __size__ ++;
-                return err_ok;              
+
+           /*
+            *  Constructs element in place at the end or at the beginning of a list, like:
+            *  
+            *    list<Cstring<20>> C;
+            *    C.emplace_back ("seven hundred");
+            *    
+            *  Constructor arguments are passed directly to element's constructor so no temporary element gets created, copied and destroyed.
+            *
+            *  Returns OK or one of the error flags in case of error:
+            *    - could not allocate enough memory for requested storage
+            */
+
+            template <typename... Args>
+            signed char emplace_back (Args&&... args) {
+                node_t *newNode = __newNode__ (static_cast<Args&&> (args)...);
+                if (newNode == NULL)
+                    return err_bad_alloc;
+                __linkAfter__ (__back__ ? __back__ : __beforeFront__ (), newNode);
+                return err_ok;
+            }
+
+            template <typename... Args>
+            signed char emplace_front (Args&&... args) {
+                node_t *newNode = __newNode__ (static_cast<Args&&> (args)...);
+                if (newNode == NULL)
+                    return err_bad_alloc;
+                __linkAfter__ (__beforeFront__ (), newNode);
+                return err_ok;
             }
 
 
@@ -284,6 +262,8 @@
                 // remove the first element
                 node_t *tmp = __front__;
                 __front__ = __front__->next;
+                if (__front__ == NULL) // the list is empty now
+                    __back__ = NULL;
                 __size__ --;
         
                 // free the space occupied by the deleted element
@@ -336,6 +316,7 @@
         private:
 
             template<typename T1, typename T2> inline __attribute__((always_inline)) bool __equals__ (const T1& a, const T2& b);
+            template<typename T1, typename T2> static inline __attribute__((always_inline)) bool __smaller__ (const T1& a, const T2& b);
 
         public:
 
@@ -401,39 +382,236 @@
 
             };
 
+            iterator before_begin () { return iterator (__beforeFront__ ()); } // before the first element, only to be used with insert_after, emplace_after and erase_after
             iterator begin () { return iterator (__front__); }              // first element
             iterator end () { return iterator (NULL); }                     // past the last element
 
+
            /*
-             * Deletes the element pointed to by iterator
-             */
+            *  Inserts element after the element pointed to by iterator, like:
+            *
+            *    auto it = E.insert_after (E.before_begin (), 500); // the same as push_front
+            *    E.insert_after (it, 550);
+            *
+            *  Since only the node pointed to by iterator needs to be changed this takes O(1) time.
+            *
+            *  Returns the iterator pointing to the inserted element or end () in case of error:
+            *    - could not allocate enough memory for requested storage
+            *    - iterator doesn't point to any element
+            */
+
+            iterator insert_after (iterator pos, const listType& element) { return emplace_after (pos, element); }
+
+            iterator insert_after (iterator pos, listType&& element) { return emplace_after (pos, static_cast<listType&&> (element)); }
+
+
+           /*
+            *  Constructs element in place after the element pointed to by iterator, like:
+            *
+            *    E.emplace_after (E.before_begin (), 500);
+            *
+            *  Constructor arguments are passed directly to element's constructor so no temporary element gets created, copied and destroyed.
+            *  Returns the iterator pointing to the inserted element or end () in case of error (the same as insert_after).
+            */
+
+            template <typename... Args>
+            iterator emplace_after (iterator pos, Args&&... args) {
+                if (!pos.__p__) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+
+                node_t *newNode = __newNode__ (static_cast<Args&&> (args)...);
+                if (newNode == NULL)
+                    return end ();
+                return __linkAfter__ (pos.__p__, newNode);
+            }
+
+
+           /*
+            *  Deletes the element that follows the element pointed to by iterator, like:
+            *
+            *    E.erase_after (E.before_begin ()); // the same as pop_front
+            *
+            *  Since the previous node is already known this takes O(1) time, which makes it suitable for deleting elements while iterating:
+            *
+            *    for (auto prev = E.before_begin (), it = E.begin (); it != E.end (); )
+            *        if (*it < 0)
+            *            it = E.erase_after (prev);
+            *        else
+            *            prev = it, ++ it;
+            *
+            *  Returns the iterator pointing to the element following the deleted one or end () if there is no such element.
+            */
+
+            iterator erase_after (iterator pos) {
+                node_t *p = pos.__p__;
+                if (!p || !p->next) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+
+                node_t *q = p->next;
+                p->next = q->next;
+                if (q == __back__) // if the last element is beeing deleted, the previous node becomes the last one
+                    __back__ = (p == __beforeFront__ ()) ? NULL : p;
+                __size__ --;
+
+                // free the space occupied by the deleted element
+                #ifndef ARDUINO_ARCH_AVR 
+                    q->~node_t ();
+                #endif
+                free (q);
+                return iterator (p->next);
+            }
+
+
+           /*
+            * Deletes the element pointed to by iterator
+            */
 
             iterator erase (iterator pos) {
                 node_t* target = pos.__p__;
                 if (!target)
                     return end (); // nothing to delete
 
-                for (node_t** p = &__front__; *p; p = &((*p)->next)) {
-                    if (*p == target) {
-                        node_t* q = *p;
-                        *p = q->next;
-                        if (q == __back__) {
-                            __back__ = NULL;
-                            if (__front__) {
-                                node_t* t = __front__;
-                                while (t->next)
-                                    t = t->next;
-                                __back__ = t;
-                            }
-                        }
+                // find the previous node first, then the deletion itself is the same as erase_after
+                for (node_t* p = __beforeFront__ (); p->next; p = p->next)
+                    if (p->next == target)
+                        return erase_after (iterator (p));
+                return end (); // iterator not found
+            }
 
-                        iterator next (q->next);
-                        delete q;
-                        __size__--;
-                        return next;
-                    }
+
+           /*
+            *  Moves elements from other list (or from the same list) to this list after the element pointed to by pos. Nodes are only relinked,
+            *  so nothing gets allocated, copied or freed and this always succeeds:
+            *
+            *    A.splice_after (A.before_begin (), B);          // move all the elements of B to the beginning of A, O(1)
+            *    A.splice_after (pos, B, it);                    // move the element following it from B, O(1)
+            *    A.splice_after (pos, B, first, last);           // move elements in (first, last) from B, O(number of elements moved)
+            */
+
+            void splice_after (iterator pos, list& other) {
+                if (&other == this || other.__front__ == NULL || !pos.__p__)
+                    return;
+                __spliceAfter__ (pos.__p__, other, other.__beforeFront__ (), other.__back__, other.__size__);
+            }
+
+            void splice_after (iterator pos, list& other, iterator it) {
+                if (!pos.__p__ || !it.__p__ || !it.__p__->next || pos.__p__ == it.__p__ || pos.__p__ == it.__p__->next)
+                    return; // nothing to move
+                __spliceAfter__ (pos.__p__, other, it.__p__, it.__p__->next, 1);
+            }
+
+            void splice_after (iterator pos, list& other, iterator first, iterator last) {
+                if (!pos.__p__ || !first.__p__ || first.__p__->next == last.__p__)
+                    return; // nothing to move
+                int n = 1;
+                node_t *q = first.__p__->next;
+                while (q->next != last.__p__) {
+                    q = q->next;
+                    n ++;
                 }
-                return end (); // iterator not found
+                __spliceAfter__ (pos.__p__, other, first.__p__, q, n);
+            }
+
+
+           /*
+            *  Moves elements from other list (or from the same list) to this list in front of the element pointed to by pos, like:
+            *
+            *    A.splice (A.end (), B);                         // move all the elements of B to the end of A
+            *    A.splice (A.begin (), B, it);                   // move the element pointed to by it from B to the beginning of A
+            *    A.splice (A.end (), B, first, last);            // move elements in [first, last) from B to the end of A
+            *
+            *  Since the list is single - linked, previous elements have to be found first. This takes O(1) time when pos is begin () or end ()
+            *  and it (or first) is other.begin (), otherwise the lists have to be searched.
+            */
+
+            void splice (iterator pos, list& other) {
+                if (&other == this || other.__front__ == NULL)
+                    return;
+                __spliceAfter__ (__prev__ (pos.__p__), other, other.__beforeFront__ (), other.__back__, other.__size__);
+            }
+
+            void splice (iterator pos, list& other, iterator it) {
+                if (!it.__p__ || pos.__p__ == it.__p__ || pos.__p__ == it.__p__->next)
+                    return; // nothing to move
+                __spliceAfter__ (__prev__ (pos.__p__), other, other.__prev__ (it.__p__), it.__p__, 1);
+            }
+
+            void splice (iterator pos, list& other, iterator first, iterator last) {
+                if (first.__p__ == last.__p__)
+                    return; // nothing to move
+                splice_after (iterator (__prev__ (pos.__p__)), other, iterator (other.__prev__ (first.__p__)), last);
+            }
+
+
+           /*
+            *  Merges other sorted list into this sorted list by relinking nodes, so nothing gets allocated, copied or freed. Elements are
+            *  compared with < operator unless a comparison function is given. When elements are equal the elements of this list go first.
+            *
+            *    A.merge (B);
+            */
+
+            void merge (list& other) { merge (other, [] (const listType& a, const listType& b) { return __smaller__ (a, b); }); }
+
+            template <typename Compare>
+            void merge (list& other, Compare smaller) {
+                if (&other == this || other.__front__ == NULL)
+                    return;
+                __front__ = __mergeChains__ (__front__, other.__front__, smaller);
+                __size__ += other.__size__;
+                other.__front__ = other.__back__ = NULL;
+                other.__size__ = 0;
+                __back__ = __front__;
+                while (__back__->next)
+                    __back__ = __back__->next;
+            }
+
+
+           /*
+            *  Reverses the order of elements in O(n) time by relinking nodes.
+            */
+
+            void reverse () {
+                node_t *prev = NULL;
+                node_t *p = __front__;
+                __back__ = __front__;
+                while (p) {
+                    node_t *q = p->next;
+                    p->next = prev;
+                    prev = p;
+                    p = q;
+                }
+                __front__ = prev;
+            }
+
+
+           /*
+            *  Sorts the list by relinking its nodes, so nothing gets allocated, copied or freed. Merge sort is stable and takes O(n log n) time.
+            *  Elements are compared with < operator unless a comparison function is given:
+            *
+            *    A.sort ();
+            *    A.sort ([] (const int& a, const int& b) { return a > b; });
+            */
+
+            void sort () { sort ([] (const listType& a, const listType& b) { return __smaller__ (a, b); }); }
+
+            template <typename Compare>
+            void sort (Compare smaller) {
+                if (__size__ < 2)
+                    return;
+                __front__ = __sortChain__ (__front__, smaller);
+                __back__ = __front__;
+                while (__back__->next)
+                    __back__ = __back__->next;
             }
 
 
@@ -455,6 +633,165 @@
             node_t *__back__ = NULL;          // points to the last list node, initially the list has no elements
             int __size__ = 0;                 // initially there are not elements in the list
 
+            // returns the address of a pseudo node whose next member is __front__, so the first node can be handled the same way as all the others (it's element must never be accessed)
+            node_t *__beforeFront__ () { return reinterpret_cast<node_t*> (reinterpret_cast<char*> (&__front__) - offsetof (node_t, next)); }
+
+            // allocates a new node and constructs its element directly from arguments, returns NULL in case of error
+            template <typename... Args>
+            node_t *__newNode__ (Args&&... args) {
+                // allocate new memory for element
+                #if LIST_MEMORY_TYPE == PSRAM_MEM
+                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
+                #else // use heap
+                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
+                #endif
+                if (newNode == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return NULL;
+                }
+
+                memset (newNode, 0, sizeof (node_t));
+                #ifndef ARDUINO_ARCH_AVR 
+                    new (&newNode->element) listType (static_cast<Args&&> (args)...); // the only construction of the element
+                #else
+                    newNode->element = listType (args...);  // objects not supported for AVR boards
+                #endif
+                return newNode;
+            }
+
+            // links already constructed newNode after node p
+            iterator __linkAfter__ (node_t *p, node_t *newNode) {
+                newNode->next = p->next;
+                p->next = newNode;
+                if (p == __back__ || __back__ == NULL) // if inserted after the last node or into an empty list
+                    __back__ = newNode;
+                __size__ ++;
+                return iterator (newNode);
+            }
+
+            // returns the node in front of node p (pseudo node if p is the first node, __back__ if p is NULL)
+            node_t *__prev__ (node_t *p) {
+                if (p == NULL)
+                    return __back__ ? __back__ : __beforeFront__ ();
+                node_t *q = __beforeFront__ ();
+                while (q->next != p)
+                    q = q->next;
+                return q;
+            }
+
+            // moves n nodes following beforeFirst up to (and including) last from other list after node pos
+            void __spliceAfter__ (node_t *pos, list& other, node_t *beforeFirst, node_t *last, int n) {
+                node_t *first = beforeFirst->next;
+
+                // unlink them from other list
+                beforeFirst->next = last->next;
+                if (other.__back__ == last)
+                    other.__back__ = (beforeFirst == other.__beforeFront__ ()) ? NULL : beforeFirst;
+                other.__size__ -= n;
+
+                // link them into this list
+                last->next = pos->next;
+                pos->next = first;
+                if (pos == __back__ || __back__ == NULL)
+                    __back__ = last;
+                __size__ += n;
+            }
+
+            // merges two sorted NULL terminated chains of nodes, nodes of a go first when elements are equal
+            template <typename Compare>
+            static node_t *__mergeChains__ (node_t *a, node_t *b, Compare& smaller) {
+                node_t *head = NULL;
+                node_t **tail = &head;
+                while (a && b) {
+                    if (smaller (b->element, a->element)) {
+                        *tail = b;
+                        b = b->next;
+                    } else {
+                        *tail = a;
+                        a = a->next;
+                    }
+                    tail = &(*tail)->next;
+                }
+                *tail = a ? a : b;
+                return head;
+            }
+
+            // sorts NULL terminated chain of nodes with bottom-up merge sort, bin [i] holds an already sorted chain of 2^i nodes, like counting in binary
+            template <typename Compare>
+            static node_t *__sortChain__ (node_t *p, Compare& smaller) {
+                node_t *bin [32] = {};
+                while (p) {
+                    node_t *carry = p;
+                    p = p->next;
+                    carry->next = NULL;
+                    int i = 0;
+                    for (; i < 31 && bin [i]; i ++) {
+                        carry = __mergeChains__ (bin [i], carry, smaller); // bin [i] holds earlier nodes, so merging stays stable
+                        bin [i] = NULL;
+                    }
+                    if (bin [i])
+                        carry = __mergeChains__ (bin [i], carry, smaller);
+                    bin [i] = carry;
+                }
+                node_t *sorted = NULL;
+                for (int i = 0; i < 32; i ++)
+                    if (bin [i])
+                        sorted = __mergeChains__ (bin [i], sorted, smaller);
+                return sorted;
+            }
+
+            // sorts nodes in [first, last) - used by sort function (algorithm.hpp) that only knows iterators, not the list, so the node before first can't be
+            // relinked and the list's pointer to its last node can't be updated: all the nodes are relinked by the stable merge sort, then the first and the last
+            // node of the range take back their places by exchanging them (and their elements) with the nodes that got there, so the order stays stable
+            template <typename Compare>
+            static void __sortRange__ (node_t *first, node_t *last, Compare smaller) {
+                if (first == last || first->next == last)
+                    return; // less than 2 elements
+                node_t *back = first;
+                while (back->next != last)
+                    back = back->next;
+                back->next = NULL;
+                node_t *head = __sortChain__ (first, smaller);
+
+                if (head != first)
+                    __exchangeNodes__ (&head, first, head);
+                node_t *p = head;
+                while (p->next)
+                    p = p->next;
+                if (p != back)
+                    __exchangeNodes__ (&head, back, p);
+                back->next = last;                              // link the sorted range back to the rest of the list
+            }
+
+            // exchanges the places of nodes a and b in NULL terminated chain and their elements, so the order of the elements stays the same
+            static void __exchangeNodes__ (node_t **chain, node_t *a, node_t *b) {
+                node_t **linkA = chain;
+                while (*linkA != a)
+                    linkA = &(*linkA)->next;
+                node_t **linkB = chain;
+                while (*linkB != b)
+                    linkB = &(*linkB)->next;
+                *linkA = b;                                     // this also works for neighbours: the links are swapped first, then the nexts
+                *linkB = a;
+                node_t *next = a->next;
+                a->next = b->next;
+                b->next = next;
+                __swapElements__ (a, b);
+            }
+
+            // swaps elements by swapping their memory so constructors and destructors don't get called
+            static void __swapElements__ (node_t *a, node_t *b) {
+                if (a == b)
+                    return;
+                char tmp [sizeof (listType)];
+                memcpy (tmp, &a->element, sizeof (listType));
+                memcpy (&a->element, &b->element, sizeof (listType));
+                memcpy (&b->element, tmp, sizeof (listType));
+            }
+
     };
 
     template<typename listType> template<typename T1, typename T2> __attribute__((always_inline)) bool list<listType>::__equals__ (const T1& a, const T2& b) { return a == b; }
@@ -463,6 +800,10 @@
     template<> template<> inline __attribute__((always_inline)) bool list<char*>::__equals__ (const char* const& a, char* const& b) { return strcmp (a, b) == 0; }
     template<> template<> inline __attribute__((always_inline)) bool list<char*>::__equals__ (char* const& a, const char* const& b) { return strcmp (a, b) == 0; }
 
+    template<typename listType> template<typename T1, typename T2> __attribute__((always_inline)) bool list<listType>::__smaller__ (const T1& a, const T2& b) { return a < b; }
+    template<> template<> inline __attribute__((always_inline)) bool list<const char*>::__smaller__ (const char* const& a, const char* const& b) { return strcmp (a, b) < 0; }
+    template<> template<> inline __attribute__((always_inline)) bool list<char*>::__smaller__ (char* const& a, char* const& b) { return strcmp (a, b) < 0; }
+
 
    /*
     * Arduino String list template specialization (a good source for template specialization: https://www.cprogramming.com/tutorial/template_specialization.html)
@@ -530,7 +871,7 @@
                     */
 
                     list (std::initializer_list<String> il) {
-                        for (String element: il) {
+                        for (const String& element: il) {
                             if (!element) {                             // ... check if parameter construction is valid
                                 #ifdef THROW_LIST_EXCEPTIONS
                                     throw err_bad_alloc;
@@ -615,6 +956,7 @@
                     p = q;
                 }
                 __front__ = NULL;
+                __back__ = NULL;
 
                 __size__ = 0;
                 clearErrorFlags ();
@@ -633,7 +975,7 @@
       
             list (list& other) {
                 // copy other's elements
-                for (String element: other) {
+                for (const String& element: other) {
                     if (!element) {                             // ... check if parameter construction is valid
                         #ifdef THROW_LIST_EXCEPTIONS
                             throw err_bad_alloc;
@@ -660,7 +1002,7 @@
                 this->clear (); // clear existing elements if needed
 
                 // copy other's elements
-                for (String element: other) {
+                for (const String& element: other) {
                     if (!element) {                             // ... check if parameter construction is valid
                         #ifdef THROW_LIST_EXCEPTIONS
                             throw err_bad_alloc;
@@ -680,50 +1022,15 @@
             *  
             *    E.push_back ("700");
             *    
+            *  The String is copy-constructed directly in the new node, or moved there if it is a temporary object.
+            *
             *  Returns OK or one of the error flags in case of error:
             *    - could not allocate enough memory for requested storage
             */
     
-            signed char push_back (String element) {
-                if (!element) {                             // ... check if parameter construction is valid
-                    #ifdef THROW_LIST_EXCEPTIONS
-                        throw err_bad_alloc;
-                    #endif
-                    __errorFlags__ |= err_bad_alloc;       // report error if it is not
-                    return err_bad_alloc;
-                }
+            signed char push_back (const String& element) { return emplace_back (element); }
 
-                // allocate new memory for element
-                #if LIST_MEMORY_TYPE == PSRAM_MEM
-                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
-                #else // use heap
-                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
-                #endif
-                if (newNode == NULL) {
-                    #ifdef THROW_LIST_EXCEPTIONS
-                        throw err_bad_alloc;
-                    #endif
-                    __errorFlags__ |= err_bad_alloc;
-                    return err_bad_alloc;
-                }
-
-                memset (newNode, 0, sizeof (node_t));
-                #ifndef ARDUINO_ARCH_AVR 
-                    new (newNode) node_t; 
-                #endif
-
-                // add the new element to the end
-                __swapStrings__ (&newNode->element, &element);
-                newNode->next = NULL;
-                if (__front__ == NULL)
-                    __front__ = newNode;
-                if (__back__ != NULL)
-                    __back__->next = newNode;
-                __back__ = newNode;
-                
-                __size__ ++;
-                return err_ok;
-            }
+            signed char push_back (String&& element) { return emplace_back (static_cast<String&&> (element)); }
 
 
            /*
@@ -735,43 +1042,36 @@
             *    - could not allocate enough memory for requested storage
             */
               
-            signed char push_front (String element) {
-                if (!element) {                             // ... check if parameter construction is valid
-                    #ifdef THROW_LIST_EXCEPTIONS
-                        throw err_bad_alloc;
-                    #endif
-                    __errorFlags__ |= err_bad_alloc;       // report error if it is not
-                    return err_bad_alloc;
-                }
+            signed char push_front (const String& element) { return emplace_front (element); }
 
-                // allocate new memory for element
-                #if LIST_MEMORY_TYPE == PSRAM_MEM
-                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
-                #else // use heap
-                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
-                #endif
-                if (newNode == NULL) {
-                    #ifdef THROW_LIST_EXCEPTIONS
-                        throw err_bad_alloc;
-                    #endif
-                    __errorFlags__ |= err_bad_alloc;
-                    return err_bad_alloc;
-                }
+            signed char push_front (String&& element) { return emplace_front (static_cast<String&&> (element)); }
 
-                memset (newNode, 0, sizeof (node_t));
-                #ifndef ARDUINO_ARCH_AVR 
-                    new (newNode) node_t; 
-                #endif
 
-                // add the new element to the beginning
-                __swapStrings__ (&newNode->element, &element);
-                newNode->next = __front__;
-                __front__ = newNode;
-                if (__back__ == NULL)
-                    __back__ = newNode;
-                
-                __size__ ++;
-                return err_ok;              
+           /*
+            *  Constructs String in place at the end or at the beginning of a list, like:
+            *  
+            *    E.emplace_back (700);
+            *    
+            *  Returns OK or one of the error flags in case of error:
+            *    - could not allocate enough memory for requested storage
+            */
+
+            template <typename... Args>
+            signed char emplace_back (Args&&... args) {
+                node_t *newNode = __newNode__ (static_cast<Args&&> (args)...);
+                if (newNode == NULL)
+                    return err_bad_alloc;
+                __linkAfter__ (__back__ ? __back__ : __beforeFront__ (), newNode);
+                return err_ok;
+            }
+
+            template <typename... Args>
+            signed char emplace_front (Args&&... args) {
+                node_t *newNode = __newNode__ (static_cast<Args&&> (args)...);
+                if (newNode == NULL)
+                    return err_bad_alloc;
+                __linkAfter__ (__beforeFront__ (), newNode);
+                return err_ok;
             }
 
 
@@ -791,6 +1091,8 @@
                 // remove the first element
                 node_t *tmp = __front__;
                 __front__ = __front__->next;
+                if (__front__ == NULL) // the list is empty now
+                    __back__ = NULL;
                 __size__ --;
         
                 // free the space occupied by the deleted element
@@ -903,39 +1205,229 @@
 
             };
 
+            iterator before_begin () { return iterator (__beforeFront__ ()); } // before the first element, only to be used with insert_after, emplace_after and erase_after
             iterator begin () { return iterator (__front__); }              // first element
             iterator end () { return iterator (NULL); }                     // past the last element
 
+
            /*
-             * Deletes the element pointed to by iterator
-             */
+            *  Inserts element after the element pointed to by iterator, like:
+            *
+            *    auto it = E.insert_after (E.before_begin (), "500"); // the same as push_front
+            *    E.insert_after (it, "550");
+            *
+            *  Since only the node pointed to by iterator needs to be changed this takes O(1) time.
+            *
+            *  Returns the iterator pointing to the inserted element or end () in case of error:
+            *    - could not allocate enough memory for requested storage
+            *    - iterator doesn't point to any element
+            */
+
+            iterator insert_after (iterator pos, const String& element) { return emplace_after (pos, element); }
+
+            iterator insert_after (iterator pos, String&& element) { return emplace_after (pos, static_cast<String&&> (element)); }
+
+
+           /*
+            *  Constructs String in place after the element pointed to by iterator, like:
+            *
+            *    E.emplace_after (E.before_begin (), "500");
+            *
+            *  Returns the iterator pointing to the inserted element or end () in case of error (the same as insert_after).
+            */
+
+            template <typename... Args>
+            iterator emplace_after (iterator pos, Args&&... args) {
+                if (!pos.__p__) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+
+                node_t *newNode = __newNode__ (static_cast<Args&&> (args)...);
+                if (newNode == NULL)
+                    return end ();
+                return __linkAfter__ (pos.__p__, newNode);
+            }
+
+
+           /*
+            *  Deletes the element that follows the element pointed to by iterator, like:
+            *
+            *    E.erase_after (E.before_begin ()); // the same as pop_front
+            *
+            *  Since the previous node is already known this takes O(1) time, which makes it suitable for deleting elements while iterating.
+            *
+            *  Returns the iterator pointing to the element following the deleted one or end () if there is no such element.
+            */
+
+            iterator erase_after (iterator pos) {
+                node_t *p = pos.__p__;
+                if (!p || !p->next) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+
+                node_t *q = p->next;
+                p->next = q->next;
+                if (q == __back__) // if the last element is beeing deleted, the previous node becomes the last one
+                    __back__ = (p == __beforeFront__ ()) ? NULL : p;
+                __size__ --;
+
+                // free the space occupied by the deleted element
+                #ifndef ARDUINO_ARCH_AVR 
+                    q->~node_t ();
+                #endif
+                free (q);
+                return iterator (p->next);
+            }
+
+
+           /*
+            * Deletes the element pointed to by iterator
+            */
 
             iterator erase (iterator pos) {
                 node_t* target = pos.__p__;
                 if (!target)
                     return end (); // nothing to delete
 
-                for (node_t** p = &__front__; *p; p = &((*p)->next)) {
-                    if (*p == target) {
-                        node_t* q = *p;
-                        *p = q->next;
-                        if (q == __back__) {
-                            __back__ = NULL;
-                            if (__front__) {
-                                node_t* t = __front__;
-                                while (t->next)
-                                    t = t->next;
-                                __back__ = t;
-                            }
-                        }
+                // find the previous node first, then the deletion itself is the same as erase_after
+                for (node_t* p = __beforeFront__ (); p->next; p = p->next)
+                    if (p->next == target)
+                        return erase_after (iterator (p));
+                return end (); // iterator not found
+            }
 
-                        iterator next (q->next);
-                        delete q;
-                        __size__--;
-                        return next;
-                    }
+
+           /*
+            *  Moves elements from other list (or from the same list) to this list after the element pointed to by pos. Nodes are only relinked,
+            *  so nothing gets allocated, copied or freed and this always succeeds:
+            *
+            *    A.splice_after (A.before_begin (), B);          // move all the elements of B to the beginning of A, O(1)
+            *    A.splice_after (pos, B, it);                    // move the element following it from B, O(1)
+            *    A.splice_after (pos, B, first, last);           // move elements in (first, last) from B, O(number of elements moved)
+            */
+
+            void splice_after (iterator pos, list& other) {
+                if (&other == this || other.__front__ == NULL || !pos.__p__)
+                    return;
+                __spliceAfter__ (pos.__p__, other, other.__beforeFront__ (), other.__back__, other.__size__);
+            }
+
+            void splice_after (iterator pos, list& other, iterator it) {
+                if (!pos.__p__ || !it.__p__ || !it.__p__->next || pos.__p__ == it.__p__ || pos.__p__ == it.__p__->next)
+                    return; // nothing to move
+                __spliceAfter__ (pos.__p__, other, it.__p__, it.__p__->next, 1);
+            }
+
+            void splice_after (iterator pos, list& other, iterator first, iterator last) {
+                if (!pos.__p__ || !first.__p__ || first.__p__->next == last.__p__)
+                    return; // nothing to move
+                int n = 1;
+                node_t *q = first.__p__->next;
+                while (q->next != last.__p__) {
+                    q = q->next;
+                    n ++;
                 }
-                return end (); // iterator not found
+                __spliceAfter__ (pos.__p__, other, first.__p__, q, n);
+            }
+
+
+           /*
+            *  Moves elements from other list (or from the same list) to this list in front of the element pointed to by pos, like:
+            *
+            *    A.splice (A.end (), B);                         // move all the elements of B to the end of A
+            *    A.splice (A.begin (), B, it);                   // move the element pointed to by it from B to the beginning of A
+            *    A.splice (A.end (), B, first, last);            // move elements in [first, last) from B to the end of A
+            *
+            *  Since the list is single - linked, previous elements have to be found first. This takes O(1) time when pos is begin () or end ()
+            *  and it (or first) is other.begin (), otherwise the lists have to be searched.
+            */
+
+            void splice (iterator pos, list& other) {
+                if (&other == this || other.__front__ == NULL)
+                    return;
+                __spliceAfter__ (__prev__ (pos.__p__), other, other.__beforeFront__ (), other.__back__, other.__size__);
+            }
+
+            void splice (iterator pos, list& other, iterator it) {
+                if (!it.__p__ || pos.__p__ == it.__p__ || pos.__p__ == it.__p__->next)
+                    return; // nothing to move
+                __spliceAfter__ (__prev__ (pos.__p__), other, other.__prev__ (it.__p__), it.__p__, 1);
+            }
+
+            void splice (iterator pos, list& other, iterator first, iterator last) {
+                if (first.__p__ == last.__p__)
+                    return; // nothing to move
+                splice_after (iterator (__prev__ (pos.__p__)), other, iterator (other.__prev__ (first.__p__)), last);
+            }
+
+
+           /*
+            *  Merges other sorted list into this sorted list by relinking nodes, so nothing gets allocated, copied or freed. Elements are
+            *  compared with < operator unless a comparison function is given. When elements are equal the elements of this list go first.
+            *
+            *    A.merge (B);
+            */
+
+            void merge (list& other) { merge (other, [] (const String& a, const String& b) { return a < b; }); }
+
+            template <typename Compare>
+            void merge (list& other, Compare smaller) {
+                if (&other == this || other.__front__ == NULL)
+                    return;
+                __front__ = __mergeChains__ (__front__, other.__front__, smaller);
+                __size__ += other.__size__;
+                other.__front__ = other.__back__ = NULL;
+                other.__size__ = 0;
+                __back__ = __front__;
+                while (__back__->next)
+                    __back__ = __back__->next;
+            }
+
+
+           /*
+            *  Reverses the order of elements in O(n) time by relinking nodes.
+            */
+
+            void reverse () {
+                node_t *prev = NULL;
+                node_t *p = __front__;
+                __back__ = __front__;
+                while (p) {
+                    node_t *q = p->next;
+                    p->next = prev;
+                    prev = p;
+                    p = q;
+                }
+                __front__ = prev;
+            }
+
+
+           /*
+            *  Sorts the list by relinking its nodes, so nothing gets allocated, copied or freed. Merge sort is stable and takes O(n log n) time.
+            *  Elements are compared with < operator unless a comparison function is given:
+            *
+            *    A.sort ();
+            *    A.sort ([] (const int& a, const int& b) { return a > b; });
+            */
+
+            void sort () { sort ([] (const String& a, const String& b) { return a < b; }); }
+
+            template <typename Compare>
+            void sort (Compare smaller) {
+                if (__size__ < 2)
+                    return;
+                __front__ = __sortChain__ (__front__, smaller);
+                __back__ = __front__;
+                while (__back__->next)
+                    __back__ = __back__->next;
             }
 
 
@@ -956,12 +1448,174 @@
             node_t *__back__ = NULL;          // points to the last list node, initially the list has no elements
             int __size__ = 0;                 // initially there are not elements in the list
 
-            // swap strings by swapping their stack memory so constructors doesn't get called and nothing can go wrong like running out of memory meanwhile 
-            void __swapStrings__ (String *a, String *b) {
+            // returns the address of a pseudo node whose next member is __front__, so the first node can be handled the same way as all the others (it's element must never be accessed)
+            node_t *__beforeFront__ () { return reinterpret_cast<node_t*> (reinterpret_cast<char*> (&__front__) - offsetof (node_t, next)); }
+
+            // allocates a new node and constructs its String directly from arguments, returns NULL in case of error
+            template <typename... Args>
+            node_t *__newNode__ (Args&&... args) {
+                // allocate new memory for element
+                #if LIST_MEMORY_TYPE == PSRAM_MEM
+                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
+                #else // use heap
+                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
+                #endif
+                if (newNode == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return NULL;
+                }
+
+                memset (newNode, 0, sizeof (node_t));
+                #ifndef ARDUINO_ARCH_AVR 
+                    new (&newNode->element) String (static_cast<Args&&> (args)...); // the only construction of the String
+                #else
+                    newNode->element = String (args...);
+                #endif
+                if (!newNode->element) {                    // ... check if construction is valid
+                    #ifndef ARDUINO_ARCH_AVR 
+                        newNode->~node_t ();
+                    #endif
+                    free (newNode);
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;       // report error if it is not
+                    return NULL;
+                }
+                return newNode;
+            }
+
+            // links already constructed newNode after node p
+            iterator __linkAfter__ (node_t *p, node_t *newNode) {
+                newNode->next = p->next;
+                p->next = newNode;
+                if (p == __back__ || __back__ == NULL) // if inserted after the last node or into an empty list
+                    __back__ = newNode;
+                __size__ ++;
+                return iterator (newNode);
+            }
+
+            // returns the node in front of node p (pseudo node if p is the first node, __back__ if p is NULL)
+            node_t *__prev__ (node_t *p) {
+                if (p == NULL)
+                    return __back__ ? __back__ : __beforeFront__ ();
+                node_t *q = __beforeFront__ ();
+                while (q->next != p)
+                    q = q->next;
+                return q;
+            }
+
+            // moves n nodes following beforeFirst up to (and including) last from other list after node pos
+            void __spliceAfter__ (node_t *pos, list& other, node_t *beforeFirst, node_t *last, int n) {
+                node_t *first = beforeFirst->next;
+
+                // unlink them from other list
+                beforeFirst->next = last->next;
+                if (other.__back__ == last)
+                    other.__back__ = (beforeFirst == other.__beforeFront__ ()) ? NULL : beforeFirst;
+                other.__size__ -= n;
+
+                // link them into this list
+                last->next = pos->next;
+                pos->next = first;
+                if (pos == __back__ || __back__ == NULL)
+                    __back__ = last;
+                __size__ += n;
+            }
+
+            // merges two sorted NULL terminated chains of nodes, nodes of a go first when elements are equal
+            template <typename Compare>
+            static node_t *__mergeChains__ (node_t *a, node_t *b, Compare& smaller) {
+                node_t *head = NULL;
+                node_t **tail = &head;
+                while (a && b) {
+                    if (smaller (b->element, a->element)) {
+                        *tail = b;
+                        b = b->next;
+                    } else {
+                        *tail = a;
+                        a = a->next;
+                    }
+                    tail = &(*tail)->next;
+                }
+                *tail = a ? a : b;
+                return head;
+            }
+
+            // sorts NULL terminated chain of nodes with bottom-up merge sort, bin [i] holds an already sorted chain of 2^i nodes, like counting in binary
+            template <typename Compare>
+            static node_t *__sortChain__ (node_t *p, Compare& smaller) {
+                node_t *bin [32] = {};
+                while (p) {
+                    node_t *carry = p;
+                    p = p->next;
+                    carry->next = NULL;
+                    int i = 0;
+                    for (; i < 31 && bin [i]; i ++) {
+                        carry = __mergeChains__ (bin [i], carry, smaller); // bin [i] holds earlier nodes, so merging stays stable
+                        bin [i] = NULL;
+                    }
+                    if (bin [i])
+                        carry = __mergeChains__ (bin [i], carry, smaller);
+                    bin [i] = carry;
+                }
+                node_t *sorted = NULL;
+                for (int i = 0; i < 32; i ++)
+                    if (bin [i])
+                        sorted = __mergeChains__ (bin [i], sorted, smaller);
+                return sorted;
+            }
+
+            // sorts nodes in [first, last) - used by sort function (algorithm.hpp) that only knows iterators, not the list, so the node before first can't be
+            // relinked and the list's pointer to its last node can't be updated: all the nodes are relinked by the stable merge sort, then the first and the last
+            // node of the range take back their places by exchanging them (and their elements) with the nodes that got there, so the order stays stable
+            template <typename Compare>
+            static void __sortRange__ (node_t *first, node_t *last, Compare smaller) {
+                if (first == last || first->next == last)
+                    return; // less than 2 elements
+                node_t *back = first;
+                while (back->next != last)
+                    back = back->next;
+                back->next = NULL;
+                node_t *head = __sortChain__ (first, smaller);
+
+                if (head != first)
+                    __exchangeNodes__ (&head, first, head);
+                node_t *p = head;
+                while (p->next)
+                    p = p->next;
+                if (p != back)
+                    __exchangeNodes__ (&head, back, p);
+                back->next = last;                              // link the sorted range back to the rest of the list
+            }
+
+            // exchanges the places of nodes a and b in NULL terminated chain and their elements, so the order of the elements stays the same
+            static void __exchangeNodes__ (node_t **chain, node_t *a, node_t *b) {
+                node_t **linkA = chain;
+                while (*linkA != a)
+                    linkA = &(*linkA)->next;
+                node_t **linkB = chain;
+                while (*linkB != b)
+                    linkB = &(*linkB)->next;
+                *linkA = b;                                     // this also works for neighbours: the links are swapped first, then the nexts
+                *linkB = a;
+                node_t *next = a->next;
+                a->next = b->next;
+                b->next = next;
+                __swapElements__ (a, b);
+            }
+
+            // swaps elements by swapping their memory so constructors and destructors don't get called
+            static void __swapElements__ (node_t *a, node_t *b) {
+                if (a == b)
+                    return;
                 char tmp [sizeof (String)];
-                memcpy (&tmp, a, sizeof (String));
-                memcpy (a, b, sizeof (String));
-                memcpy (b, tmp, sizeof (String));
+                memcpy (tmp, &a->element, sizeof (String));
+                memcpy (&a->element, &b->element, sizeof (String));
+                memcpy (&b->element, tmp, sizeof (String));
             }
 
     };
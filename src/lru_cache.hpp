@@ -0,0 +1,487 @@
+/*
+ *  lru_cache.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Least recently used cache with a fixed capacity (and an optional byte budget). The pairs are kept in a double linked recency list, the most recently
+ *  used one is at the front, the least recently used one at the back is evicted when there is no room for a new pair. The pairs are found through a hash
+ *  index of node pointers, which is allocated once for the whole capacity, so get, put and evict all take O (1) time and never rehash.
+ *
+ *  lru_cache functions are not thread-safe.
+ *
+ *  March 7, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __LRU_CACHE_HPP__
+    #define __LRU_CACHE_HPP__
+
+
+    #include "Map.hpp"              // error flags, memory type and node pool are shared with Map
+    #include "unordered_map.hpp"    // hash functions are shared with unordered_map
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want lru_cache to throw exceptions (the same setting as for Map)
+
+
+    template <class keyType, class valueType> class lru_cache {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+            struct Pair {
+                keyType first;          // key
+                valueType second;       // value
+            };
+
+
+           /*
+            *  Constructor of lru_cache takes the maximum number of pairs and optionally the maximum number of bytes the pairs may occupy
+            *  (nodes plus the characters of String keys and values), 0 means no byte limit:
+            *
+            *    lru_cache<String, String> pages (16, 32 * 1024);
+            */
+
+            lru_cache (size_t capacity, size_t byteBudget = 0) {
+                __capacity__ = capacity > 0 ? capacity : 1;
+                __byteBudget__ = byteBudget;
+            }
+
+            lru_cache (const lru_cache&) = delete;
+            lru_cache& operator = (const lru_cache&) = delete;
+
+
+           /*
+            *  lru_cache destructor - free the memory occupied by pairs
+            */
+
+            ~lru_cache () {
+                clear ();
+                if (__index__ != NULL)
+                    free (__index__);
+            }
+
+
+           /*
+            *  Returns the number of pairs, the maximum number of pairs and the number of bytes the pairs occupy.
+            */
+
+            size_t size () const { return __size__; }
+
+            size_t capacity () const { return __capacity__; }
+
+            size_t bytes () const { return __bytes__; }
+
+
+           /*
+            *  Checks if there are no pairs.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Statistics: get calls that found the key (hits), get calls that didn't (misses) and the pairs that were evicted to make room for new ones.
+            */
+
+            unsigned long hits () const { return __hits__; }
+
+            unsigned long misses () const { return __misses__; }
+
+            unsigned long evictions () const { return __evictions__; }
+
+            void resetStatistics () { __hits__ = __misses__ = __evictions__ = 0; }
+
+
+           /*
+            *  Clears all the pairs (statistics are kept).
+            */
+
+            void clear () {
+                while (__front__ != NULL) {
+                    __lruNode__ *n = __front__;
+                    __front__ = n->next;
+                    __freeNode__ (n);
+                }
+                __back__ = NULL;
+                if (__index__ != NULL)
+                    memset (__index__, 0, (__indexMask__ + 1) * sizeof (__indexSlot__));
+                __size__ = 0;
+                __bytes__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  Returns the pointer to the value of the pair with the key and makes the pair the most recently used one, or NULL if there is no such pair.
+            *  Key can be of any type comparable to keyType (like const char * for String keys). Example:
+            *
+            *    String *page = pages.get ("/index.html");
+            *    if (page)
+            *        send (*page);
+            */
+
+            template <class K>
+            valueType *get (const K& key) {
+
+                if (is_same<K, String>::value)            // if key is of type String ...
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return NULL;
+                    }
+
+                __lruNode__ *n = __find__ (key);
+                if (n == NULL) {
+                    __misses__ ++;
+                    return NULL;
+                }
+                __hits__ ++;
+                __moveToFront__ (n);
+                return &n->pair.second;
+            }
+
+
+           /*
+            *  Like get, but doesn't change the order of pairs or the statistics.
+            */
+
+            template <class K>
+            valueType *peek (const K& key) {
+                __lruNode__ *n = __find__ (key);
+                return n ? &n->pair.second : NULL;
+            }
+
+            template <class K>
+            bool contains (const K& key) const { return __find__ (key) != NULL; }
+
+
+           /*
+            *  Inserts a new pair or replaces the value of an existing one and makes the pair the most recently used one. The least recently used pairs are
+            *  evicted when the cache is full or over its byte budget. Returns OK or err_bad_alloc (also when the pair alone exceeds the byte budget).
+            */
+
+            signed char put (const keyType& key, const valueType& value) {
+
+                if (is_same<keyType, String>::value)      // if key is of type String ...
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+
+                if (is_same<valueType, String>::value)    // if value is of type String ...
+                    if (!*(String *) &value) {            // ... check if parameter construction is valid
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+
+                uint32_t hash = __unorderedMapHash__ (key);
+                __lruNode__ *n = __find__ (key, hash);
+                if (n != NULL) {                          // the key is already cached, replace the value
+                    __bytes__ -= __bytesOf__ (n->pair);
+                    n->pair.second = value;
+                    if (is_same<valueType, String>::value && !*(String *) &n->pair.second) {
+                        n->pair.second = valueType ();    // leave a valid (empty) String to be destructed
+                        __bytes__ += __bytesOf__ (n->pair);
+                        __erase__ (n);
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return err_bad_alloc;
+                    }
+                    __bytes__ += __bytesOf__ (n->pair);
+                    __moveToFront__ (n);
+                    __evictOverBudget__ ();
+                    return err_ok;
+                }
+
+                // make room for a new pair
+                if (__index__ == NULL && !__allocateIndex__ ())
+                    return err_bad_alloc;
+                size_t newBytes = sizeof (__lruNode__) + __bytesOf__ (key) + __bytesOf__ (value);
+                if (__byteBudget__ && newBytes > __byteBudget__) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                while (__size__ >= __capacity__ || (__byteBudget__ && __bytes__ + newBytes > __byteBudget__))
+                    __evict__ ();
+
+                n = (__lruNode__ *) __nodePool__ ().allocate ();
+                if (n == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                memset (n, 0, sizeof (__lruNode__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->pair) Pair { key, value };
+                #else
+                    n->pair.first = key;
+                    n->pair.second = value;
+                #endif
+
+                // in case of Strings - it is possible that key and value didn't get constructed
+                if ((is_same<keyType, String>::value && !*(String *) &n->pair.first) || (is_same<valueType, String>::value && !*(String *) &n->pair.second)) {
+                    __freeNode__ (n);
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+
+                // link it at the front of the recency list and into the index
+                n->next = __front__;
+                if (__front__)
+                    __front__->prev = n;
+                __front__ = n;
+                if (__back__ == NULL)
+                    __back__ = n;
+                size_t i = hash & __indexMask__;
+                while (__index__ [i].node != NULL)
+                    i = (i + 1) & __indexMask__;
+                __index__ [i] = { hash, n };
+                __size__ ++;
+                __bytes__ += __bytesOf__ (n->pair);
+                return err_ok;
+            }
+
+
+           /*
+            *  Erases the pair with the key, returns OK or err_not_found.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+                __lruNode__ *n = __find__ (key);
+                if (n == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return err_not_found;
+                }
+                __erase__ (n);
+                return err_ok;
+            }
+
+
+           /*
+            *  Iterator goes from the most recently used pair to the least recently used one, it doesn't change the order of pairs. Example:
+            *
+            *    for (auto& pair: pages)
+            *        Serial.println (pair.first);
+            */
+
+        private:
+
+            struct __lruNode__;             // forward private declaration
+
+        public:
+
+            class iterator {
+
+              public:
+
+                iterator (lru_cache::__lruNode__ *node) { __node__ = node; }
+
+                Pair& operator *() { return __node__->pair; }
+
+                Pair * operator -> () { return &__node__->pair; }
+
+                iterator& operator ++ () { __node__ = __node__->next; return *this; }
+
+                friend bool operator != (const iterator& a, const iterator& b) { return a.__node__ != b.__node__; }
+                friend bool operator == (const iterator& a, const iterator& b) { return a.__node__ == b.__node__; }
+
+              private:
+
+                lru_cache::__lruNode__ *__node__;
+
+            };
+
+            iterator begin () { return iterator (__front__); }
+            iterator end ()   { return iterator (NULL); }
+
+            #ifdef __OSTREAM_HPP__
+                // print lru_cache to ostream, from the most recently used pair to the least recently used one
+                friend ostream& operator << (ostream& os, lru_cache& c) {
+                    bool first = true;
+                    for (auto& e : c) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << "{" << e.first << "," << e.second << "}";
+                    }
+                    return os;
+                }
+            #endif
+
+        private:
+
+            struct __lruNode__ {
+                Pair pair;
+                __lruNode__ *prev;                  // towards the most recently used pair
+                __lruNode__ *next;                  // towards the least recently used pair
+            };
+
+            // hash index: open addressing with linear probing, the slots only point to the nodes, so the keys are stored only once
+            struct __indexSlot__ {
+                uint32_t hash;
+                __lruNode__ *node;                  // NULL means free slot
+            };
+
+            __indexSlot__ *__index__ = NULL;
+            size_t __indexMask__ = 0;               // the number of index slots - 1, the index is at most 3/4 full
+            __lruNode__ *__front__ = NULL;
+            __lruNode__ *__back__ = NULL;
+            size_t __capacity__;
+            size_t __size__ = 0;
+            size_t __byteBudget__;
+            size_t __bytes__ = 0;
+            unsigned long __hits__ = 0;
+            unsigned long __misses__ = 0;
+            unsigned long __evictions__ = 0;
+
+            // node memory comes from the pool
+            typedef __mapNodePool__<sizeof (__lruNode__)> __nodePool_t__;
+            #ifdef MAP_SHARED_NODE_POOL
+                __nodePool_t__& __nodePool__ () { return __nodePool_t__::shared (); }
+            #else
+                __nodePool_t__ __ownNodePool__;
+                __nodePool_t__& __nodePool__ () { return __ownNodePool__; }
+            #endif
+
+            void __freeNode__ (__lruNode__ *n) {
+                n->~__lruNode__ ();
+                __nodePool__ ().deallocate (n);
+            }
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            // bytes counted against the byte budget: nodes and the characters of Strings
+            template <class T> static size_t __bytesOf__ (const T&) { return 0; }
+            static size_t __bytesOf__ (const String& s) { return s.length () + 1; }
+            static size_t __bytesOf__ (const Pair& p) { return sizeof (__lruNode__) + __bytesOf__ (p.first) + __bytesOf__ (p.second); }
+
+            bool __allocateIndex__ () {
+                size_t slots = 4;
+                while (slots < __capacity__ + __capacity__ / 3 + 1)
+                    slots <<= 1;
+                #if MAP_MEMORY_TYPE == PSRAM_MEM
+                    __index__ = (__indexSlot__ *) ps_malloc (slots * sizeof (__indexSlot__));
+                #else
+                    __index__ = (__indexSlot__ *) malloc (slots * sizeof (__indexSlot__));
+                #endif
+                if (__index__ == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return false;
+                }
+                memset (__index__, 0, slots * sizeof (__indexSlot__));
+                __indexMask__ = slots - 1;
+                return true;
+            }
+
+            // returns the node with the key or NULL if it is not found, numbers are converted to keyType first, so they hash the same as the keys
+            template <class K>
+            __lruNode__ *__find__ (const K& probe) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                return __find__ (key, __unorderedMapHash__ (key));
+            }
+
+            template <class K>
+            __lruNode__ *__find__ (const K& key, uint32_t hash) const {
+                if (__index__ == NULL)
+                    return NULL;
+                for (size_t i = hash & __indexMask__; __index__ [i].node != NULL; i = (i + 1) & __indexMask__)
+                    if (__index__ [i].hash == hash && __unorderedMapEqual__ (__index__ [i].node->pair.first, key))
+                        return __index__ [i].node;
+                return NULL;
+            }
+
+            void __moveToFront__ (__lruNode__ *n) {
+                if (n == __front__)
+                    return;
+                n->prev->next = n->next;            // unlink
+                if (n->next)
+                    n->next->prev = n->prev;
+                else
+                    __back__ = n->prev;
+                n->prev = NULL;                     // link at the front
+                n->next = __front__;
+                __front__->prev = n;
+                __front__ = n;
+            }
+
+            // removes the node from the recency list and the index and frees it
+            void __erase__ (__lruNode__ *n) {
+                if (n->prev)
+                    n->prev->next = n->next;
+                else
+                    __front__ = n->next;
+                if (n->next)
+                    n->next->prev = n->prev;
+                else
+                    __back__ = n->prev;
+
+                // find the slot pointing to n and close the gap by shifting back the following slots that would rather be closer to their home slots
+                size_t i = __unorderedMapHash__ (n->pair.first) & __indexMask__;
+                while (__index__ [i].node != n)
+                    i = (i + 1) & __indexMask__;
+                for (size_t j = (i + 1) & __indexMask__; __index__ [j].node != NULL; j = (j + 1) & __indexMask__) {
+                    size_t home = __index__ [j].hash & __indexMask__;
+                    if (((j - home) & __indexMask__) >= ((j - i) & __indexMask__)) { // slot i lies between home and j
+                        __index__ [i] = __index__ [j];
+                        i = j;
+                    }
+                }
+                __index__ [i] = { 0, NULL };
+
+                __size__ --;
+                __bytes__ -= __bytesOf__ (n->pair);
+                __freeNode__ (n);
+            }
+
+            void __evict__ () {
+                __erase__ (__back__);
+                __evictions__ ++;
+            }
+
+            // after a value grows, the older pairs may need to make room for it
+            void __evictOverBudget__ () {
+                while (__byteBudget__ && __bytes__ > __byteBudget__ && __back__ != __front__)
+                    __evict__ ();
+            }
+
+    };
+
+#endif
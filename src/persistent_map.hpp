@@ -0,0 +1,579 @@
+/*
+ *  persistent_map.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Map with copy-on-write snapshots. The pairs are kept in a balanced (AVL) binary search tree whose nodes never change once they are built.
+ *  Inserting or erasing a pair copies only the nodes on the path from the root to the pair (path copying), O (log n) of them, all the other
+ *  nodes are shared with the previous versions of the tree. Nodes count the references to them and are freed when the last version that
+ *  uses them is gone.
+ *
+ *  Copying a persistent_map (taking a snapshot) is therefore O (1): the copy just references the current root. A snapshot never changes,
+ *  so the task that holds it can read it without any locking, while another task keeps changing the original and publishing new roots:
+ *
+ *    persistent_map<String, String> config;                 // changed by the control loop task
+ *    ...
+ *    persistent_map<String, String> view = config.snapshot (); // web server task, O (1)
+ *    auto p = view.find ("ssid");                            // no locks, view doesn't change while it is being read
+ *
+ *  Only taking a snapshot and publishing a new root lock a mutex (for O (1) time). A persistent_map object must be changed by one task at
+ *  a time, other tasks should read their own snapshots. Nodes are allocated with malloc (or ps_malloc) rather than from Map's node pool,
+ *  since they may be freed by whichever task releases the last snapshot that uses them.
+ *
+ *  April 4, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __PERSISTENT_MAP_HPP__
+    #define __PERSISTENT_MAP_HPP__
+
+
+    #include "Map.hpp"              // error flags, memory type and key comparison are shared with Map
+
+    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+        #include <atomic>
+        #include <mutex>
+    #endif
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want persistent_map to throw exceptions (the same setting as for Map)
+
+    #define __PERSISTENT_MAP_MAX_HEIGHT__ 48 // AVL trees with 2^32 nodes are less than 46 levels high
+
+
+    template <class keyType, class valueType, class keyCompare = map_compare> class persistent_map {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+            struct __persistentNode__;  // forward declaration, defined below
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+            struct Pair {
+                keyType first;          // node key
+                valueType second;       // node value
+            };
+
+
+           /*
+            *  Constructor of persistent_map with no pairs:
+            *
+            *    persistent_map<String, int> pmA;
+            */
+
+            persistent_map () {}
+
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+               /*
+                *  Constructor of persistent_map from brace enclosed initializer list:
+                *
+                *     persistent_map<int, String> pmB = { {1, "one"}, {2, "two"} };
+                */
+
+                persistent_map (std::initializer_list<Pair> il) {
+                    for (auto i: il)
+                        if (insert (i.first, i.second))
+                            break;
+                }
+          #endif
+
+
+           /*
+            *  Constructor of persistent_map from Map, the pairs are already sorted so the tree is built in O (n):
+            *
+            *    Map<String, String> mp = { {"ssid", "home"}, {"password", "secret"} };
+            *    persistent_map<String, String> config (mp);
+            */
+
+            template <class mapCompare>
+            persistent_map (Map<keyType, valueType, mapCompare>& other) {
+                size_t n = other.size ();
+                if (n == 0)
+                    return;
+                typedef typename Map<keyType, valueType, mapCompare>::Pair mapPair;
+                mapPair **pairs = (mapPair **) malloc (n * sizeof (mapPair *));
+                if (pairs == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return;
+                }
+                size_t i = 0;
+                for (auto& e : other)
+                    pairs [i ++] = &e;
+                signed char e = err_ok;
+                __root__ = __build__ (pairs, n, e);
+                free (pairs);
+                if (e != err_ok)
+                    __root__ = NULL;
+                else
+                    __size__ = n;
+            }
+
+
+           /*
+            *  Copy-constructor takes a snapshot of the other persistent_map in O (1), the pairs are shared, not copied.
+            */
+
+            persistent_map (const persistent_map& other) {
+                other.__lock__ ();
+                __root__ = __retain__ (other.__root__);
+                __size__ = other.__size__;
+                other.__unlock__ ();
+            }
+
+
+           /*
+            *  Assignment operator also takes a snapshot of the other persistent_map in O (1).
+            */
+
+            persistent_map& operator = (const persistent_map& other) {
+                if (this != &other) {
+                    other.__lock__ ();
+                    __persistentNode__ *root = __retain__ (other.__root__);
+                    size_t size = other.__size__;
+                    other.__unlock__ ();
+                    __publish__ (root, size);
+                }
+                return *this;
+            }
+
+
+           /*
+            *  persistent_map destructor releases its root, the nodes that are not used by other snapshots are freed
+            */
+
+            ~persistent_map () { __release__ (__root__); }
+
+
+           /*
+            *  Returns a snapshot of the current version, the same as copying persistent_map.
+            */
+
+            persistent_map snapshot () const { return persistent_map (*this); }
+
+
+           /*
+            *  Returns the number of pairs and the height of the tree.
+            */
+
+            size_t size () const { return __size__; }
+
+            int height () const { return __height__ (__root__); }
+
+
+           /*
+            *  Checks if there are no pairs.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Returns a pointer to the pair with the key or NULL if the key is not found. The pair stays valid as long as this persistent_map
+            *  object is not changed (or as long as any snapshot that contains it exists):
+            *
+            *    auto p = view.find ("ssid");
+            *    if (p)
+            *        cout << p->second;
+            */
+
+            template <class K>
+            const Pair *find (const K& probe) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                __persistentNode__ *p = __root__;
+                while (p != NULL) {
+                    int c = keyCompare::compare (key, p->pair.first);
+                    if (c == 0)
+                        return &p->pair;
+                    p = c < 0 ? p->left : p->right;
+                }
+                return NULL;
+            }
+
+
+           /*
+            *  Checks if the key is in persistent_map.
+            */
+
+            template <class K>
+            bool contains (const K& key) const { return find (key) != NULL; }
+
+
+           /*
+            *  Inserts a new pair and publishes the new version, returns OK or one of the errors. Snapshots taken before don't see the change.
+            */
+
+            signed char insert (const keyType& key, const valueType& value) {
+                signed char e = err_ok;
+                __persistentNode__ *root = __insert__ (__root__, key, value, false, e);
+                if (e != err_ok)
+                    return __error__ (e);
+                __publish__ (root, __size__ + 1);
+                return err_ok;
+            }
+
+
+           /*
+            *  Inserts a new pair or assigns the value to the existing key and publishes the new version, returns OK or one of the errors.
+            */
+
+            signed char insert_or_assign (const keyType& key, const valueType& value) {
+                signed char e = err_ok;
+                bool inserted = false;
+                __persistentNode__ *root = __insert__ (__root__, key, value, true, e, &inserted);
+                if (e != err_ok)
+                    return __error__ (e);
+                __publish__ (root, __size__ + (inserted ? 1 : 0));
+                return err_ok;
+            }
+
+
+           /*
+            *  Erases the pair with the key and publishes the new version, returns OK or one of the errors.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+                signed char e = err_ok;
+                __persistentNode__ *root = __erase__ (__root__, __mapProbe__<keyType, K>::key (key), e);
+                if (e != err_ok)
+                    return __error__ (e);
+                __publish__ (root, __size__ - 1);
+                return err_ok;
+            }
+
+
+           /*
+            *  Publishes an empty version, the nodes are freed when no snapshot uses them any more.
+            */
+
+            void clear () { __publish__ (NULL, 0); }
+
+
+           /*
+            *  Iterator visits the pairs in the order of their keys. It keeps the path from the root on its own stack, since nodes are shared
+            *  between versions and can't point back to their parents.
+            */
+
+            class iterator {
+
+                public:
+
+                    iterator (__persistentNode__ *root) {
+                        __push__ (root);
+                    }
+
+                    const Pair& operator * () const { return __stack__ [__depth__ - 1]->pair; }
+
+                    const Pair * operator -> () const { return &__stack__ [__depth__ - 1]->pair; }
+
+                    iterator& operator ++ () {
+                        __persistentNode__ *p = __stack__ [-- __depth__];
+                        __push__ (p->right);
+                        return *this;
+                    }
+
+                    bool operator != (const iterator& other) const { return __depth__ != other.__depth__ || (__depth__ > 0 && __stack__ [__depth__ - 1] != other.__stack__ [__depth__ - 1]); }
+
+                    bool operator == (const iterator& other) const { return !(*this != other); }
+
+                private:
+
+                    __persistentNode__ *__stack__ [__PERSISTENT_MAP_MAX_HEIGHT__];
+                    int __depth__ = 0;
+
+                    void __push__ (__persistentNode__ *p) {
+                        for ( ; p != NULL; p = p->left)
+                            __stack__ [__depth__ ++] = p;
+                    }
+
+            };
+
+            iterator begin () const { return iterator (__root__); }
+
+            iterator end () const { return iterator (NULL); }
+
+
+            #ifdef __OSTREAM_HPP__
+                // print persistent_map to ostream
+                friend ostream& operator << (ostream& os, const persistent_map& m) {
+                    bool first = true;
+                    for (auto& e : m) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << "{" << e.first << "," << e.second << "}";
+                    }
+                    return os;
+                }
+            #endif
+
+
+        private:
+
+            #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                typedef std::atomic<int> __referenceCount__;
+            #else
+                typedef int __referenceCount__;     // no other tasks on AVR boards
+            #endif
+
+            struct __persistentNode__ {
+                __persistentNode__ *left;
+                __persistentNode__ *right;
+                __referenceCount__ references;      // roots and parents that point to the node
+                int8_t height;
+                Pair pair;
+            };
+
+            __persistentNode__ *__root__ = NULL;
+            size_t __size__ = 0;
+
+            #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                mutable std::mutex __mutex__;       // guards __root__ and __size__ only while a snapshot is taken or a new root is published
+                void __lock__ () const { __mutex__.lock (); }
+                void __unlock__ () const { __mutex__.unlock (); }
+            #else
+                void __lock__ () const {}
+                void __unlock__ () const {}
+            #endif
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            signed char __error__ (signed char e) {
+                #ifdef USE_MAP_EXCEPTIONS
+                    throw e;
+                #endif
+                __errorFlags__ |= e;
+                return e;
+            }
+
+            // replaces the root under the lock, the previous root is released afterwards, outside the lock
+            void __publish__ (__persistentNode__ *root, size_t size) {
+                __lock__ ();
+                __persistentNode__ *old = __root__;
+                __root__ = root;
+                __size__ = size;
+                __unlock__ ();
+                __release__ (old);
+            }
+
+            static int __height__ (const __persistentNode__ *p) { return p != NULL ? p->height : 0; }
+
+            static __persistentNode__ *__retain__ (__persistentNode__ *p) {
+                if (p != NULL)
+                    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                        p->references.fetch_add (1, std::memory_order_relaxed);
+                    #else
+                        p->references ++;
+                    #endif
+                return p;
+            }
+
+            // drops one reference, the node is freed together with the references it holds when the last one is dropped
+            static void __release__ (__persistentNode__ *p) {
+                while (p != NULL) {
+                    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                        if (p->references.fetch_sub (1, std::memory_order_acq_rel) != 1)
+                            return;
+                    #else
+                        if (-- p->references != 0)
+                            return;
+                    #endif
+                    __persistentNode__ *left = p->left;
+                    __persistentNode__ *right = p->right;
+                    p->pair.~Pair ();
+                    p->references.~__referenceCount__ ();
+                    free (p);
+                    __release__ (left);
+                    p = right;                      // the right subtree is released in the loop instead of recursively
+                }
+            }
+
+            // builds a new node that takes over the references to its subtrees, on failure the references are released and NULL is returned
+            __persistentNode__ *__newNode__ (const keyType& key, const valueType& value, __persistentNode__ *left, __persistentNode__ *right, signed char& e) {
+                #if MAP_MEMORY_TYPE == PSRAM_MEM
+                    __persistentNode__ *n = (__persistentNode__ *) ps_malloc (sizeof (__persistentNode__));
+                #else
+                    __persistentNode__ *n = (__persistentNode__ *) malloc (sizeof (__persistentNode__));
+                #endif
+                if (n == NULL) {
+                    __release__ (left);
+                    __release__ (right);
+                    e = err_bad_alloc;
+                    return NULL;
+                }
+
+                memset ((void *) n, 0, sizeof (__persistentNode__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->references) __referenceCount__ (1);
+                    new (&n->pair) Pair { key, value };
+                #else
+                    n->references = 1;
+                    n->pair.first = key;
+                    n->pair.second = value;
+                #endif
+
+                // in case of Strings - it is possible that key and value didn't get constructed
+                if ((is_same<keyType, String>::value && !*(String *) &n->pair.first) || (is_same<valueType, String>::value && !*(String *) &n->pair.second)) {
+                    n->left = left;
+                    n->right = right;
+                    __release__ (n);
+                    e = err_bad_alloc;
+                    return NULL;
+                }
+
+                n->left = left;
+                n->right = right;
+                n->height = 1 + (__height__ (left) > __height__ (right) ? __height__ (left) : __height__ (right));
+                return n;
+            }
+
+            // builds a balanced node from the pair and the subtrees (their heights differ by at most 2), rotating by building new nodes when needed
+            __persistentNode__ *__balance__ (const Pair& pair, __persistentNode__ *left, __persistentNode__ *right, signed char& e) {
+                if (e != err_ok) {
+                    __release__ (left);
+                    __release__ (right);
+                    return NULL;
+                }
+
+                if (__height__ (left) > __height__ (right) + 1) {
+                    __persistentNode__ *l = left;
+                    if (__height__ (l->left) >= __height__ (l->right)) {    // single right rotation
+                        __persistentNode__ *b = __newNode__ (pair.first, pair.second, __retain__ (l->right), right, e);
+                        __persistentNode__ *root = e == err_ok ? __newNode__ (l->pair.first, l->pair.second, __retain__ (l->left), b, e) : NULL;
+                        __release__ (l);
+                        return root;
+                    } else {                                                // double rotation, l->right becomes the root
+                        __persistentNode__ *lr = l->right;
+                        __persistentNode__ *a = __newNode__ (l->pair.first, l->pair.second, __retain__ (l->left), __retain__ (lr->left), e);
+                        __persistentNode__ *b = __newNode__ (pair.first, pair.second, __retain__ (lr->right), right, e);
+                        __persistentNode__ *root = NULL;
+                        if (e == err_ok) {
+                            root = __newNode__ (lr->pair.first, lr->pair.second, a, b, e);   // takes over a and b
+                        } else {
+                            __release__ (a);
+                            __release__ (b);
+                        }
+                        __release__ (l);
+                        return root;
+                    }
+                }
+
+                if (__height__ (right) > __height__ (left) + 1) {
+                    __persistentNode__ *r = right;
+                    if (__height__ (r->right) >= __height__ (r->left)) {    // single left rotation
+                        __persistentNode__ *a = __newNode__ (pair.first, pair.second, left, __retain__ (r->left), e);
+                        __persistentNode__ *root = e == err_ok ? __newNode__ (r->pair.first, r->pair.second, a, __retain__ (r->right), e) : NULL;
+                        __release__ (r);
+                        return root;
+                    } else {                                                // double rotation, r->left becomes the root
+                        __persistentNode__ *rl = r->left;
+                        __persistentNode__ *a = __newNode__ (pair.first, pair.second, left, __retain__ (rl->left), e);
+                        __persistentNode__ *b = __newNode__ (r->pair.first, r->pair.second, __retain__ (rl->right), __retain__ (r->right), e);
+                        __persistentNode__ *root = NULL;
+                        if (e == err_ok) {
+                            root = __newNode__ (rl->pair.first, rl->pair.second, a, b, e);   // takes over a and b
+                        } else {
+                            __release__ (a);
+                            __release__ (b);
+                        }
+                        __release__ (r);
+                        return root;
+                    }
+                }
+
+                return __newNode__ (pair.first, pair.second, left, right, e);
+            }
+
+            // returns the new version of subtree p with the pair inserted (or assigned), p itself doesn't change
+            __persistentNode__ *__insert__ (__persistentNode__ *p, const keyType& key, const valueType& value, bool assign, signed char& e, bool *inserted = NULL) {
+                if (p == NULL) {
+                    if (inserted != NULL)
+                        *inserted = true;
+                    return __newNode__ (key, value, NULL, NULL, e);
+                }
+                int c = keyCompare::compare (key, p->pair.first);
+                if (c == 0) {
+                    if (!assign) {
+                        e = err_not_unique;
+                        return NULL;
+                    }
+                    return __newNode__ (p->pair.first, value, __retain__ (p->left), __retain__ (p->right), e);
+                }
+                if (c < 0) {
+                    __persistentNode__ *left = __insert__ (p->left, key, value, assign, e, inserted);
+                    return __balance__ (p->pair, left, e == err_ok ? __retain__ (p->right) : NULL, e);
+                } else {
+                    __persistentNode__ *right = __insert__ (p->right, key, value, assign, e, inserted);
+                    return __balance__ (p->pair, e == err_ok ? __retain__ (p->left) : NULL, right, e);
+                }
+            }
+
+            // returns the new version of subtree p without its leftmost node, which is returned in *leftmost
+            __persistentNode__ *__eraseLeftmost__ (__persistentNode__ *p, __persistentNode__ **leftmost, signed char& e) {
+                if (p->left == NULL) {
+                    *leftmost = p;
+                    return __retain__ (p->right);
+                }
+                __persistentNode__ *left = __eraseLeftmost__ (p->left, leftmost, e);
+                return __balance__ (p->pair, left, e == err_ok ? __retain__ (p->right) : NULL, e);
+            }
+
+            // returns the new version of subtree p without the key, p itself doesn't change
+            template <class K>
+            __persistentNode__ *__erase__ (__persistentNode__ *p, const K& key, signed char& e) {
+                if (p == NULL) {
+                    e = err_not_found;
+                    return NULL;
+                }
+                int c = keyCompare::compare (key, p->pair.first);
+                if (c < 0) {
+                    __persistentNode__ *left = __erase__ (p->left, key, e);
+                    return __balance__ (p->pair, left, e == err_ok ? __retain__ (p->right) : NULL, e);
+                }
+                if (c > 0) {
+                    __persistentNode__ *right = __erase__ (p->right, key, e);
+                    return __balance__ (p->pair, e == err_ok ? __retain__ (p->left) : NULL, right, e);
+                }
+                if (p->left == NULL)
+                    return __retain__ (p->right);
+                if (p->right == NULL)
+                    return __retain__ (p->left);
+                __persistentNode__ *leftmost;                                // the next pair takes the place of the erased one
+                __persistentNode__ *right = __eraseLeftmost__ (p->right, &leftmost, e);
+                return __balance__ (leftmost->pair, e == err_ok ? __retain__ (p->left) : NULL, right, e);
+            }
+
+            // builds a perfectly balanced tree from sorted pairs
+            template <class pairType>
+            __persistentNode__ *__build__ (pairType **pairs, size_t n, signed char& e) {
+                if (n == 0 || e != err_ok)
+                    return NULL;
+                size_t m = n / 2;
+                __persistentNode__ *left = __build__ (pairs, m, e);
+                __persistentNode__ *right = __build__ (pairs + m + 1, n - m - 1, e);
+                if (e != err_ok) {
+                    __release__ (left);
+                    __release__ (right);
+                    return NULL;
+                }
+                return __newNode__ (pairs [m]->first, pairs [m]->second, left, right, e);
+            }
+
+    };
+
+#endif
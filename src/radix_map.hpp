@@ -0,0 +1,494 @@
+/*
+ *  radix_map.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Compressed radix tree (trie) of string keys. Each node holds a label - a part of the key - so the keys that share a prefix share the nodes
+ *  of the prefix and the prefix is stored only once. A node's children are kept in a sibling list ordered by the first character of their
+ *  labels, so the keys are visited in alphabetical order. Besides finding a key, radix_map can find the longest key that is a prefix of a
+ *  string (URL routing, for example) and visit all the keys that start with a prefix (topics under "home/livingroom/", for example).
+ *
+ *  Keys can be C strings, Strings or Cstrings. The nodes are moved with memcpy when they are split or merged, so values must not point into themselves.
+ *
+ *  radix_map functions are not thread-safe.
+ *
+ *  March 28, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __RADIX_MAP_HPP__
+    #define __RADIX_MAP_HPP__
+
+
+    #include "Map.hpp"              // error flags and memory type are shared with Map
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want radix_map to throw exceptions (the same setting as for Map)
+
+
+    // keys of different types are all searched as C strings
+    inline const char *__radixKey__ (const char *key) { return key != NULL ? key : ""; }
+    inline const char *__radixKey__ (const String& key) { return key.c_str (); }
+    template <size_t N> struct Cstring;     // Cstring.hpp may be included after radix_map.hpp
+    template <size_t N> inline const char *__radixKey__ (const Cstring<N>& key) { return key.c_str (); }
+
+
+    template <class valueType> class radix_map {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+
+            radix_map () {}
+
+            radix_map (const radix_map&) = delete;
+            radix_map& operator = (const radix_map&) = delete;
+
+
+           /*
+            *  radix_map destructor - free the memory occupied by nodes
+            */
+
+            ~radix_map () { clear (); }
+
+
+           /*
+            *  Returns the number of keys and the number of bytes the nodes occupy (keys are included, since they are stored in node labels).
+            */
+
+            size_t size () const { return __size__; }
+
+            size_t bytes () const { return __bytes__; }
+
+
+           /*
+            *  Checks if there are no keys.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Inserts a new key-value pair, returns OK or one of the errors:
+            *
+            *    radix_map<void (*) ()> routes;
+            *    routes.insert ("/api/status", onStatus);
+            *    if (routes.insert ("/api/status", onOther) == err_not_unique) ...
+            */
+
+            template <class K>
+            signed char insert (const K& key, const valueType& value) {
+                const char *k = __radixKey__ (key);
+                size_t keyLength = strlen (k);
+                if (__root__ == NULL && (__root__ = __newNode__ ("", 0)) == NULL)
+                    return err_bad_alloc;
+                __radixNode__ **nLink = &__root__;
+                __radixNode__ *n = __root__;
+
+                while (*k) {
+                    __radixNode__ **link = __childLink__ (n, *k);
+                    __radixNode__ *c = *link;
+
+                    if (c == NULL || c->label [0] != *k) {              // no child continues the key, the rest of the key becomes a new leaf
+                        __radixNode__ *leaf = __newNode__ (k, strlen (k));
+                        if (leaf != NULL && !__setValue__ (leaf, value)) {
+                            __freeNode__ (leaf);
+                            leaf = NULL;
+                        }
+                        if (leaf == NULL) {
+                            if (n != __root__)
+                                __merge__ (nLink);                      // undo the split, if there was one
+                            return err_bad_alloc;
+                        }
+                        leaf->nextSibling = c;
+                        *link = leaf;
+                        __size__ ++;
+                        if (keyLength > __longestKey__)
+                            __longestKey__ = keyLength;
+                        return err_ok;
+                    }
+
+                    size_t i = 1;
+                    while (c->label [i] && c->label [i] == k [i])
+                        i++;
+                    if (c->label [i]) {                                 // the key leaves the label in the middle, split the label there
+                        if (!__split__ (link, i))
+                            return err_bad_alloc;
+                        c = *link;
+                    }
+                    nLink = link;
+                    n = c;
+                    k += i;
+                }
+
+                if (n->hasValue) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_unique;
+                    #endif
+                    __errorFlags__ |= err_not_unique;
+                    return err_not_unique;
+                }
+                if (!__setValue__ (n, value))
+                    return err_bad_alloc;
+                __size__ ++;
+                if (keyLength > __longestKey__)
+                    __longestKey__ = keyLength;
+                return err_ok;
+            }
+
+
+           /*
+            *  Returns a pointer to the value of the key or NULL if the key is not found.
+            */
+
+            template <class K>
+            valueType *find (const K& key) const {
+                const char *k = __radixKey__ (key);
+                __radixNode__ *n = __root__;
+                while (n != NULL && *k) {
+                    n = *__childLink__ (n, *k);
+                    if (n == NULL || n->label [0] != *k)
+                        return NULL;
+                    const char *l = n->label;
+                    while (*l && *l == *k) {
+                        l++;
+                        k++;
+                    }
+                    if (*l)
+                        return NULL;
+                }
+                return n != NULL && n->hasValue ? &n->value : NULL;
+            }
+
+
+           /*
+            *  Checks if the key is in radix_map.
+            */
+
+            template <class K>
+            bool contains (const K& key) const { return find (key) != NULL; }
+
+
+           /*
+            *  Returns a pointer to the value of the longest key that is a prefix of the string, or NULL if there is no such key.
+            *  The length of the key found is returned in *length if it is not NULL:
+            *
+            *    size_t length;
+            *    auto handler = routes.longest_prefix ("/api/status/wifi", &length);     // finds "/api/status", length = 11
+            */
+
+            template <class K>
+            valueType *longest_prefix (const K& str, size_t *length = NULL) const {
+                const char *s = __radixKey__ (str);
+                const char *k = s;
+                __radixNode__ *n = __root__;
+                valueType *found = NULL;
+                while (n != NULL) {
+                    if (n->hasValue) {
+                        found = &n->value;
+                        if (length != NULL)
+                            *length = k - s;
+                    }
+                    if (!*k)
+                        break;
+                    n = *__childLink__ (n, *k);
+                    if (n == NULL || n->label [0] != *k)
+                        break;
+                    const char *l = n->label;
+                    while (*l && *l == *k) {
+                        l++;
+                        k++;
+                    }
+                    if (*l)
+                        break;
+                }
+                return found;
+            }
+
+
+           /*
+            *  Calls function (key, value) for all the keys that start with the prefix, in alphabetical order, and returns the number of calls.
+            *  The key is passed as a const char * that is valid only during the call:
+            *
+            *    void printTopic (const char *topic, int& value) { cout << topic << " = " << value << endl; }
+            *    ...
+            *    topics.for_each_prefix ("home/livingroom/", printTopic);
+            */
+
+            template <class K, class F>
+            size_t for_each_prefix (const K& prefix, F function) {
+                const char *k = __radixKey__ (prefix);
+                __radixNode__ *n = __root__;
+                if (n == NULL)
+                    return 0;
+                char *key = (char *) malloc (__longestKey__ + 1);
+                if (key == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return 0;
+                }
+                size_t length = 0;
+                while (*k) {                                            // find the node where the prefix ends, collecting the labels on the way
+                    n = *__childLink__ (n, *k);
+                    if (n == NULL || n->label [0] != *k) {
+                        free (key);
+                        return 0;
+                    }
+                    const char *l = n->label;
+                    while (*l && *l == *k) {
+                        key [length ++] = *l ++;
+                        k++;
+                    }
+                    if (*k && *l) {                                     // the prefix leaves the label in the middle
+                        free (key);
+                        return 0;
+                    }
+                    while (*l)                                          // the prefix ends in the middle of the label, all the keys below still match
+                        key [length ++] = *l ++;
+                }
+                size_t count = __visit__ (n, key, length, function);
+                free (key);
+                return count;
+            }
+
+
+           /*
+            *  Calls function (key, value) for all the keys in alphabetical order and returns the number of calls.
+            */
+
+            template <class F>
+            size_t for_each (F function) { return for_each_prefix ("", function); }
+
+
+           /*
+            *  Erases the key, returns OK or err_not_found. Labels are merged again when a node is left with only one child and no value.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+                const char *k = __radixKey__ (key);
+                __radixNode__ **parentLink = NULL;
+                __radixNode__ **link = &__root__;
+                bool found = *link != NULL;
+                while (found && *k) {
+                    __radixNode__ **childLink = __childLink__ (*link, *k);
+                    __radixNode__ *c = *childLink;
+                    if (c == NULL || c->label [0] != *k) {
+                        found = false;
+                        break;
+                    }
+                    const char *l = c->label;
+                    while (*l && *l == *k) {
+                        l++;
+                        k++;
+                    }
+                    if (*l) {                                           // the key ends or leaves in the middle of the label
+                        found = false;
+                        break;
+                    }
+                    parentLink = link;
+                    link = childLink;
+                }
+                __radixNode__ *n = found ? *link : NULL;
+                if (n == NULL || !n->hasValue) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return err_not_found;
+                }
+
+                n->value.~valueType ();
+                n->hasValue = false;
+                __size__ --;
+
+                if (n == __root__)
+                    return err_ok;
+                if (n->firstChild == NULL) {                            // remove the leaf, its parent may be left with a single child
+                    *link = n->nextSibling;
+                    __freeNode__ (n);
+                    if (parentLink != NULL && *parentLink != __root__)
+                        __merge__ (parentLink);
+                } else {
+                    __merge__ (link);
+                }
+                return err_ok;
+            }
+
+
+           /*
+            *  Erases all the keys.
+            */
+
+            void clear () {
+                if (__root__ != NULL)
+                    __clear__ (__root__);
+                __root__ = NULL;
+                __size__ = 0;
+                __longestKey__ = 0;
+            }
+
+
+        private:
+
+            struct __radixNode__ {
+                __radixNode__ *firstChild;
+                __radixNode__ *nextSibling;
+                valueType value;            // constructed only if hasValue
+                bool hasValue;
+                char label [1];             // the rest of the label follows the node
+            };
+
+            __radixNode__ *__root__ = NULL; // the root has an empty label, it holds the value of the empty key
+            size_t __size__ = 0;
+            size_t __bytes__ = 0;
+            size_t __longestKey__ = 0;
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            // returns the link to the first child whose label doesn't start before c, which is where a child starting with c is or should be inserted
+            static __radixNode__ **__childLink__ (__radixNode__ *n, char c) {
+                __radixNode__ **link = &n->firstChild;
+                while (*link != NULL && (unsigned char) (*link)->label [0] < (unsigned char) c)
+                    link = &(*link)->nextSibling;
+                return link;
+            }
+
+            // allocates a node without a value with room for length + extra characters of the label, the first length characters of label are copied
+            __radixNode__ *__newNode__ (const char *label, size_t length, bool reportErrors = true, size_t extra = 0) {
+                #if MAP_MEMORY_TYPE == PSRAM_MEM
+                    __radixNode__ *n = (__radixNode__ *) ps_malloc (sizeof (__radixNode__) + length + extra);
+                #else
+                    __radixNode__ *n = (__radixNode__ *) malloc (sizeof (__radixNode__) + length + extra);
+                #endif
+                if (n == NULL) {
+                    if (reportErrors) {
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                    }
+                    return NULL;
+                }
+                memset ((void *) n, 0, sizeof (__radixNode__));
+                memcpy (n->label, label, length);               // the extra characters are filled later
+                n->label [length] = 0;
+                __bytes__ += sizeof (__radixNode__) + length + extra;
+                return n;
+            }
+
+            void __freeNode__ (__radixNode__ *n) {
+                __bytes__ -= sizeof (__radixNode__) + strlen (n->label);
+                free (n);
+            }
+
+            // constructs the value in a node, returns false if it couldn't be constructed
+            bool __setValue__ (__radixNode__ *n, const valueType& value) {
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->value) valueType (value);
+                #else
+                    n->value = value;
+                #endif
+
+                // in case of Strings - it is possible that the value didn't get constructed
+                if (is_same<valueType, String>::value && !*(String *) &n->value) {
+                    n->value.~valueType ();
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return false;
+                }
+                n->hasValue = true;
+                return true;
+            }
+
+            // splits the label of *link after i characters, the first part becomes a new parent node without a value
+            bool __split__ (__radixNode__ **link, size_t i) {
+                __radixNode__ *c = *link;
+                __radixNode__ *p = __newNode__ (c->label, i);
+                if (p == NULL)
+                    return false;
+                __radixNode__ *d = __newNode__ (c->label + i, strlen (c->label + i));
+                if (d == NULL) {
+                    __freeNode__ (p);
+                    return false;
+                }
+                // move the rest of c to d: children and value, the label has already been copied
+                d->firstChild = c->firstChild;
+                memcpy ((void *) &d->value, (void *) &c->value, sizeof (valueType));
+                d->hasValue = c->hasValue;
+                p->firstChild = d;
+                p->nextSibling = c->nextSibling;
+                *link = p;
+                __freeNode__ (c);
+                return true;
+            }
+
+            // merges *link with its only child if it has no value, so that the labels stay compressed, leaves the tree as it is if there is not enough memory
+            void __merge__ (__radixNode__ **link) {
+                __radixNode__ *n = *link;
+                __radixNode__ *c = n->firstChild;
+                if (n->hasValue || c == NULL || c->nextSibling != NULL)
+                    return;
+                size_t nLength = strlen (n->label);
+                size_t cLength = strlen (c->label);
+                __radixNode__ *m = __newNode__ (n->label, nLength, false, cLength);
+                if (m == NULL)
+                    return;
+                memcpy (m->label + nLength, c->label, cLength + 1);
+                m->firstChild = c->firstChild;
+                memcpy ((void *) &m->value, (void *) &c->value, sizeof (valueType));
+                m->hasValue = c->hasValue;
+                m->nextSibling = n->nextSibling;
+                *link = m;
+                __freeNode__ (c);
+                __freeNode__ (n);
+            }
+
+            // calls the function for the node and all the nodes below it, key [0 .. length) is the key of the node
+            template <class F>
+            size_t __visit__ (__radixNode__ *n, char *key, size_t length, F& function) {
+                size_t count = 0;
+                if (n->hasValue) {
+                    key [length] = 0;
+                    function ((const char *) key, n->value);
+                    count ++;
+                }
+                for (__radixNode__ *c = n->firstChild; c != NULL; c = c->nextSibling) {
+                    size_t l = strlen (c->label);
+                    memcpy (key + length, c->label, l);
+                    count += __visit__ (c, key, length + l, function);
+                }
+                return count;
+            }
+
+            void __clear__ (__radixNode__ *n) {
+                while (n != NULL) {
+                    __radixNode__ *next = n->nextSibling;
+                    if (n->firstChild != NULL)
+                        __clear__ (n->firstChild);
+                    if (n->hasValue)
+                        n->value.~valueType ();
+                    __freeNode__ (n);
+                    n = next;
+                }
+            }
+
+    };
+
+#endif
@@ -0,0 +1,700 @@
+/*
+ *  set.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  set, multiset and multimap are built on the same balanced binary search tree core as Map, but their nodes hold only what they store: set and multiset
+ *  nodes hold just the key, so set<int> doesn't waste memory for values like Map<int, bool> does. multiset and multimap keep the elements with equal keys
+ *  in the tree itself, in the order they were inserted, so multimap<K, V> needs no list of values (and no extra allocation) for each key.
+ *
+ *  set, multiset and multimap functions are not thread-safe.
+ *
+ *  March 14, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __SET_HPP__
+    #define __SET_HPP__
+
+
+    #include "Map.hpp" // error flags, memory type, node pool, key comparison and balanced binary search tree core are shared with Map
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want set, multiset and multimap to throw exceptions (the same setting as for Map)
+
+
+    // multimap's elements
+    template <class keyType, class valueType> struct __multimapPair__ {
+        keyType first;          // key
+        valueType second;       // value
+    };
+
+    // the key of an element: set and multiset elements are the keys themselves, multimap elements are pairs
+    template <class T> inline const T& __sortedTreeKey__ (const T& element) { return element; }
+    template <class K, class V> inline const K& __sortedTreeKey__ (const __multimapPair__<K, V>& pair) { return pair.first; }
+    template <class T> struct __sortedTreeKeyType__ { typedef T type; };
+    template <class K, class V> struct __sortedTreeKeyType__<__multimapPair__<K, V> > { typedef K type; };
+
+    // in case of Strings - it is possible that they didn't get constructed, the other types are always valid
+    template <class T> inline bool __sortedTreeValid__ (const T&) { return true; }
+    inline bool __sortedTreeValid__ (const String& s) { return !!s; }
+    template <class K, class V> inline bool __sortedTreeValid__ (const __multimapPair__<K, V>& pair) { return __sortedTreeValid__ (pair.first) && __sortedTreeValid__ (pair.second); }
+
+
+    /*
+     *  The common part of set, multiset and multimap. The elements are kept sorted by their keys, if uniqueKeys is false the elements with equal keys
+     *  are inserted after the existing ones.
+     */
+
+    template <class elementType, bool uniqueKeys> class __sortedTree__ {
+
+        protected:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+
+           /*
+            *  Destructor - free the memory occupied by elements
+            */
+
+            ~__sortedTree__ () { __clear__ (); }
+
+
+           /*
+            *  Returns the number of elements.
+            */
+
+            int size () const { return __size__; }
+
+
+           /*
+            *  Returns the height of balanced binary search tree.
+            */
+
+            signed char height () const { return __tree__::__subtreeHeight__ (__root__); }
+
+
+           /*
+            *  Checks if there are no elements.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Clears all the elements.
+            */
+
+            void clear () {
+                __clear__ ();
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *   Iterator visits the elements in the order of their keys, the elements with equal keys in the order they were inserted.
+            */
+
+        protected:
+
+            struct __sortedTreeNode__;                      // forward declaration
+
+        public:
+
+            class iterator {
+
+                public:
+
+                    iterator (__sortedTree__ *st, __sortedTreeNode__ *node) {
+                        __st__ = st;
+                        __node__ = node;
+                    }
+
+                    // * operator
+                    elementType& operator *() { return __node__->element; }
+
+                    // -> operator
+                    elementType * operator -> () { return &(__node__->element); }
+
+                    // ++ (prefix) increment moves to the next element
+                    iterator& operator ++ () {
+                        __node__ = __tree__::__next__ (__node__);              // NULL if there are no more nodes, which is end ()
+                        return *this;
+                    }
+
+                    // -- (prefix) decrement moves to the previous element
+                    iterator& operator -- () {
+                        if (__node__ == NULL) {                                 // we came here with -- end (), start with the last (rightmost) element
+                            if (__st__->__root__ != NULL)
+                                __node__ = __tree__::__rightmost__ (__st__->__root__);
+                        } else {
+                            __node__ = __tree__::__previous__ (__node__);
+                        }
+                        return *this;
+                    }
+
+                    // C++ will stop iterating when != operator returns false, this is when all nodes have been visited
+                    friend bool operator != (const iterator& a, const iterator& b) { return a.__node__ != b.__node__; }
+                    friend bool operator == (const iterator& a, const iterator& b) { return a.__node__ == b.__node__; }
+
+                    // this will tell if iterator is valid (if there are not elements the iterator can not be valid)
+                    operator bool () const { return __st__->size () > 0; }
+
+                private:
+
+                    friend class __sortedTree__;
+
+                    __sortedTree__ *__st__ = NULL;                              // needed for -- end () and erase
+                    __sortedTreeNode__ *__node__ = NULL;                        // NULL means end ()
+
+            };
+
+            iterator begin () { return iterator (this, __root__ ? __tree__::__leftmost__ (__root__) : NULL); }
+            iterator end ()   { return iterator (this, NULL); }
+
+
+           /*
+            *  Returns an iterator to the (first) element with the key, end () if there is no such element. The key can be of any type comparable to keyType.
+            */
+
+            template <class K>
+            iterator find (const K& key) {
+                if (!__sortedTreeValid__ (key)) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return end ();
+                }
+                return iterator (this, __find__ (key));
+            }
+
+            template <class K>
+            bool contains (const K& key) const { return __find__ (key) != NULL; }
+
+
+           /*
+            *  Returns the number of elements with the key, this is 0 or 1 for set.
+            */
+
+            template <class K>
+            int count (const K& probe) const {
+                const auto& key = __mapProbe__<__keyType__, K>::key (probe);
+                int c = 0;
+                for (__sortedTreeNode__ *p = __find__ (key); p && !__mapLess__ (key, __sortedTreeKey__ (p->element)); p = __tree__::__next__ (p))
+                    c ++;
+                return c;
+            }
+
+
+           /*
+            *  lower_bound returns an iterator to the first element with the key not less than the given key, upper_bound returns an iterator to the first element
+            *  with the key greater than the given key, end () if there is no such element.
+            */
+
+            template <class K>
+            iterator lower_bound (const K& probe) {
+                const auto& key = __mapProbe__<__keyType__, K>::key (probe);
+                __sortedTreeNode__ *p = __root__;
+                __sortedTreeNode__ *bound = NULL;
+                while (p) {
+                    if (__mapLess__ (__sortedTreeKey__ (p->element), key)) {
+                        p = p->rightSubtree;                // the bound is in the right subtree
+                    } else {
+                        bound = p;                          // p is a candidate, but there may be a lower one in the left subtree
+                        p = p->leftSubtree;
+                    }
+                }
+                return iterator (this, bound);
+            }
+
+            template <class K>
+            iterator upper_bound (const K& probe) {
+                const auto& key = __mapProbe__<__keyType__, K>::key (probe);
+                __sortedTreeNode__ *p = __root__;
+                __sortedTreeNode__ *bound = NULL;
+                while (p) {
+                    if (__mapLess__ (key, __sortedTreeKey__ (p->element))) {
+                        bound = p;                          // p is a candidate, but there may be a lower one in the left subtree
+                        p = p->leftSubtree;
+                    } else {
+                        p = p->rightSubtree;                // the bound is in the right subtree
+                    }
+                }
+                return iterator (this, bound);
+            }
+
+
+           /*
+            *  A range of elements [first, second) that can be iterated through like:
+            *
+            *    for (auto& pair: mm.equal_range (key))
+            *        Serial.println (pair.second);
+            */
+
+            struct range {
+                iterator first;
+                iterator second;
+
+                iterator begin () { return first; }
+                iterator end () { return second; }
+            };
+
+            // returns the range of the elements with the key
+            template <class K>
+            range equal_range (const K& key) { return { lower_bound (key), upper_bound (key) }; }
+
+
+           /*
+            *  Erases all the elements with the key. Returns OK or err_not_found or err_bad_alloc if String key parameter could not be constructed.
+            */
+
+            template <class K>
+            signed char erase (const K& probe) {
+                const auto& key = __mapProbe__<__keyType__, K>::key (probe);
+                if (!__sortedTreeValid__ (key)) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+
+                __sortedTreeNode__ *p = __find__ (key);
+                if (p == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return err_not_found;
+                }
+                // relinking doesn't change the order of the remaining nodes, so the next node can be found before the node is taken out of the tree
+                while (p && !__mapLess__ (key, __sortedTreeKey__ (p->element))) {
+                    __sortedTreeNode__ *next = __tree__::__next__ (p);
+                    __erase__ (p);
+                    p = next;
+                }
+                return err_ok;
+            }
+
+
+           /*
+            *  Erases the element the iterator points to (just one of the elements with equal keys) and returns the iterator to the next element, so
+            *  the elements can be erased while iterating:
+            *
+            *    for (auto it = ms.begin (); it != ms.end (); )
+            *        if (*it % 2) it = ms.erase (it); else ++ it;
+            */
+
+            iterator erase (iterator position) {
+                if (position.__node__ == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return end ();
+                }
+                __sortedTreeNode__ *next = __tree__::__next__ (position.__node__);
+                __erase__ (position.__node__);
+                return iterator (this, next);
+            }
+
+
+        protected:
+
+            // balanced binary search tree of elements, nodes have no room for anything but the links and the element
+
+            struct __sortedTreeNode__ {
+                __sortedTreeNode__ *leftSubtree;
+                __sortedTreeNode__ *rightSubtree;
+                __sortedTreeNode__ *parent;
+                int8_t leftSubtreeHeight;
+                int8_t rightSubtreeHeight;
+                #ifdef MAP_ORDER_STATISTICS
+                    int subtreeSize;
+                #endif
+                elementType element;                        // key (set, multiset) or pair (multimap), small keys fit into the padding after the heights
+            };
+
+            typedef __balancedBinarySearchTree__<__sortedTreeNode__> __tree__;
+            typedef typename __sortedTreeKeyType__<elementType>::type __keyType__;   // numbers that are searched for are converted to it
+
+            __sortedTreeNode__ *__root__ = NULL;
+            int __size__ = 0;
+
+            // node memory comes from the pool
+            typedef __mapNodePool__<sizeof (__sortedTreeNode__)> __nodePool_t__;
+            #ifdef MAP_SHARED_NODE_POOL
+                __nodePool_t__& __nodePool__ () { return __nodePool_t__::shared (); }
+            #else
+                __nodePool_t__ __ownNodePool__;
+                __nodePool_t__& __nodePool__ () { return __ownNodePool__; }
+            #endif
+
+            void __freeNode__ (__sortedTreeNode__ *n) {
+                n->~__sortedTreeNode__ ();
+                __nodePool__ ().deallocate (n);
+            }
+
+            // returns the (first) node with the key or NULL if it is not found
+            template <class K>
+            __sortedTreeNode__ *__find__ (const K& probe) const {
+                const auto& key = __mapProbe__<__keyType__, K>::key (probe);
+                __sortedTreeNode__ *p = __root__;
+                __sortedTreeNode__ *found = NULL;
+                while (p) {
+                    if (__mapLess__ (key, __sortedTreeKey__ (p->element))) {
+                        p = p->leftSubtree;                                 // continue searching in left subtree
+                    } else if (__mapLess__ (__sortedTreeKey__ (p->element), key)) {
+                        p = p->rightSubtree;                                // continue searching in right subtree
+                    } else {
+                        found = p;
+                        if (uniqueKeys)
+                            break;
+                        p = p->leftSubtree;                                 // there may be more elements with equal keys on the left
+                    }
+                }
+                return found;
+            }
+
+            // inserts a copy of the element, element must be valid (constructed), it may get swapped with the copy if copying fails, returns OK or one of the errors
+            signed char __insert__ (elementType& element) {
+                __sortedTreeNode__ **p = &__root__;
+                __sortedTreeNode__ *parent = NULL;
+
+                // find the leaf where the new node belongs, the elements with equal keys go to the right, after the existing ones
+                while (*p != NULL) {
+                    parent = *p;
+                    if (__mapLess__ (__sortedTreeKey__ (element), __sortedTreeKey__ ((*p)->element))) {
+                        p = &((*p)->leftSubtree);
+                    } else if (!uniqueKeys || __mapLess__ (__sortedTreeKey__ ((*p)->element), __sortedTreeKey__ (element))) {
+                        p = &((*p)->rightSubtree);
+                    } else {                            // the element with the same key already exists
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_not_unique;
+                        #endif
+                        __errorFlags__ |= err_not_unique;
+                        return err_not_unique;
+                    }
+                }
+
+                // get the memory for a new node from the pool
+                __sortedTreeNode__ *n = (__sortedTreeNode__ *) __nodePool__ ().allocate ();
+                if (n == NULL) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+
+                memset (n, 0, sizeof (__sortedTreeNode__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&n->element) elementType;
+                #endif
+                n->element = element;
+
+                // in case of Strings - it is possible that the copy didn't get constructed, so just swap stack memory with the parameter - this always succeeds
+                if (!__sortedTreeValid__ (n->element))
+                    __swapElements__ (&n->element, &element);
+
+                __size__ ++;
+                __tree__::__link__ (n, parent, p, &__root__);
+                return err_ok;
+            }
+
+            void __erase__ (__sortedTreeNode__ *n) {
+                __tree__::__unlink__ (n, &__root__);
+                __freeNode__ (n);
+                __size__ --;
+            }
+
+            void __clear__ () {
+                while (__sortedTreeNode__ *n = __tree__::__takeFirst__ (&__root__)) {
+                    __freeNode__ (n);
+                    __size__ --;
+                }
+            }
+
+            // replaces the elements with the copies of other's elements, they are already sorted so the balanced binary search tree can be built directly
+            void __assign__ (__sortedTree__& other) {
+                __clear__ ();
+                __errorFlags__ |= other.__errorFlags__;
+                size_t n = other.__size__;
+                if (n == 0)
+                    return;
+
+                __sortedTreeNode__ *nodes = (__sortedTreeNode__ *) __nodePool__ ().allocate (n);
+                if (nodes == NULL) { // there is no contiguous block of memory large enough, insert the elements one by one
+                    for (auto e: other)
+                        if (__insert__ (e) == err_bad_alloc)
+                            return;
+                    return;
+                }
+                size_t stride = __nodePool_t__::stride ();
+
+                // construct the nodes in the order of keys
+                size_t i = 0;
+                for (__sortedTreeNode__ *o = __tree__::__leftmost__ (other.__root__); o; o = __tree__::__next__ (o), i ++) {
+                    __sortedTreeNode__ *p = (__sortedTreeNode__ *) ((char *) nodes + i * stride);
+                    memset (p, 0, sizeof (__sortedTreeNode__));
+                    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                        new (&p->element) elementType (o->element);
+                    #else
+                        p->element = o->element;
+                    #endif
+
+                    // in case of Strings - it is possible that the copy didn't get constructed
+                    if (!__sortedTreeValid__ (p->element)) {
+                        for (size_t j = 0; j <= i; j ++)
+                            __freeNode__ ((__sortedTreeNode__ *) ((char *) nodes + j * stride));
+                        for (size_t j = i + 1; j < n; j ++)
+                            __nodePool__ ().deallocate ((char *) nodes + j * stride);
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;
+                        return;
+                    }
+                }
+
+                __tree__::__linkBalanced__ (nodes, stride, n, &__root__);
+                __size__ = n;
+            }
+
+            // swap elements by swapping their memory so constructors doesn't get called and nothing can go wrong like running out of memory meanwhile
+            static void __swapElements__ (elementType *a, elementType *b) {
+                char tmp [sizeof (elementType)];
+                memcpy (tmp, a, sizeof (elementType));
+                memcpy (a, b, sizeof (elementType));
+                memcpy (b, tmp, sizeof (elementType));
+            }
+
+    };
+
+
+    /*
+     *  set keeps unique keys, insert returns err_not_unique if the key is already there. Example:
+     *
+     *    set<int> ids = { 7, 3, 5 };
+     *    ids.insert (4);
+     *    if (ids.contains (5))
+     *        ...
+     */
+
+    template <class keyType> class set : public __sortedTree__<keyType, true> {
+
+        public:
+
+            set () {}
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                set (std::initializer_list<keyType> il) {
+                    for (auto key: il)
+                        if (insert (key) == err_bad_alloc)
+                            return;
+                }
+          #endif
+
+            // constructor accepting the array by reference, since AVR boards do not support initializer lists
+            template <int N>
+            set (const keyType (&array) [N]) {
+                for (int i = 0; i < N; ++i)
+                    if (insert (array [i]) == err_bad_alloc)
+                        break;
+            }
+
+            set (set& other) { this->__assign__ (other); }
+
+            set* operator = (set other) {
+                this->__assign__ (other);
+                return this;
+            }
+
+
+           /*
+            *  Inserts a new key, returns OK or one of the errors.
+            */
+
+            signed char insert (keyType key) {
+                if (!__sortedTreeValid__ (key)) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    this->__errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                return this->__insert__ (key);
+            }
+
+            #ifdef __OSTREAM_HPP__
+                // print set to ostream
+                friend ostream& operator << (ostream& os, set& s) {
+                    bool first = true;
+                    for (const auto& e : s) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << e;
+                    }
+                    return os;
+                }
+            #endif
+
+    };
+
+
+    /*
+     *  multiset keeps equal keys as well, count tells how many of them there are. Example:
+     *
+     *    multiset<int> readings = { 21, 22, 21 };
+     *    int c = readings.count (21); // 2
+     */
+
+    template <class keyType> class multiset : public __sortedTree__<keyType, false> {
+
+        public:
+
+            multiset () {}
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                multiset (std::initializer_list<keyType> il) {
+                    for (auto key: il)
+                        if (insert (key) == err_bad_alloc)
+                            return;
+                }
+          #endif
+
+            // constructor accepting the array by reference, since AVR boards do not support initializer lists
+            template <int N>
+            multiset (const keyType (&array) [N]) {
+                for (int i = 0; i < N; ++i)
+                    if (insert (array [i]) == err_bad_alloc)
+                        break;
+            }
+
+            multiset (multiset& other) { this->__assign__ (other); }
+
+            multiset* operator = (multiset other) {
+                this->__assign__ (other);
+                return this;
+            }
+
+
+           /*
+            *  Inserts a key after the equal keys that are already there, returns OK or one of the errors.
+            */
+
+            signed char insert (keyType key) {
+                if (!__sortedTreeValid__ (key)) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    this->__errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                return this->__insert__ (key);
+            }
+
+            #ifdef __OSTREAM_HPP__
+                // print multiset to ostream
+                friend ostream& operator << (ostream& os, multiset& s) {
+                    bool first = true;
+                    for (const auto& e : s) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << e;
+                    }
+                    return os;
+                }
+            #endif
+
+    };
+
+
+    /*
+     *  multimap keeps the pairs with equal keys in the order they were inserted. Example:
+     *
+     *    multimap<String, String> routes;
+     *    routes.insert ("/", "index.html");
+     *    routes.insert ("/", "index.htm");
+     *    for (auto& pair: routes.equal_range ("/"))
+     *        Serial.println (pair.second);
+     */
+
+    template <class keyType, class valueType> class multimap : public __sortedTree__<__multimapPair__<keyType, valueType>, false> {
+
+        public:
+
+            typedef __multimapPair__<keyType, valueType> Pair;
+
+            multimap () {}
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                multimap (std::initializer_list<Pair> il) {
+                    for (auto pair: il)
+                        if (insert (pair) == err_bad_alloc)
+                            return;
+                }
+          #endif
+
+            // constructor accepting the array by reference, since AVR boards do not support initializer lists
+            template <int N>
+            multimap (const Pair (&array) [N]) {
+                for (int i = 0; i < N; ++i)
+                    if (insert (array [i]) == err_bad_alloc)
+                        break;
+            }
+
+            multimap (multimap& other) { this->__assign__ (other); }
+
+            multimap* operator = (multimap other) {
+                this->__assign__ (other);
+                return this;
+            }
+
+
+           /*
+            *  Inserts a pair after the pairs with equal keys that are already there, returns OK or one of the errors.
+            */
+
+            signed char insert (Pair pair) {
+                if (!__sortedTreeValid__ (pair)) {
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    this->__errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                return this->__insert__ (pair);
+            }
+
+            signed char insert (keyType key, valueType value) { return insert (Pair { key, value }); }
+
+            #ifdef __OSTREAM_HPP__
+                // print multimap to ostream
+                friend ostream& operator << (ostream& os, multimap& m) {
+                    bool first = true;
+                    for (const auto& e : m) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << "{" << e.first << "," << e.second << "}";
+                    }
+                    return os;
+                }
+            #endif
+
+    };
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ *  snapshot.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Binary snapshots of containers (Map, vector) that can be saved to and loaded from a Stream (like File, Serial, ...) or a FILE *.
+ *
+ *  Snapshot layout:
+ *
+ *    | header (16 bytes)                                                      | records ...      | checksum (4 bytes) |
+ *    | 'L' 'S' 'T' 'L' | count (4) | key size (2) | value size (2) | version (1) | 3 reserved bytes |
+ *
+ *  Numbers, structures, Cstrings, ... are written as they are in memory, so loading them takes no parsing. Strings are written as their length (2 bytes)
+ *  followed by their characters, so a String longer than 65535 characters can't be saved (save returns err_bad_data). The checksum is FNV-1a of header and records. Snapshots are meant to be loaded by the same kind of board that saved them.
+ *
+ *  February 28, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __SNAPSHOT_HPP__
+    #define __SNAPSHOT_HPP__
+
+
+    // error flags: in addition to the errors of the containers - please note that all errors are negative (char) numbers
+    #define err_ok              ((signed char) 0b00000000)  //    0 - no error
+    #define err_bad_alloc       ((signed char) 0b10000001)  // -127 - out of memory
+    #define err_bad_data        ((signed char) 0b10010000)  // -112 - the snapshot couldn't be written or read or it is not valid
+
+    #define __SNAPSHOT_VERSION__ 1
+
+
+    // values are written and read as they are in memory, so they must not point to any other memory: pointers (C string keys) and classes with their own
+    // copy constructors (structures with String members, for example) are rejected at compile time, Cstrings are fine since they hold their characters
+    // (AVR compilers don't have type_traits, so the values are not checked there)
+    #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+        #include <type_traits>
+
+        template <class T> struct __snapshotRaw__ { static const bool value = std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value; };
+        template <size_t N> struct Cstring;
+        template <size_t N> struct __snapshotRaw__<Cstring<N> > { static const bool value = true; };
+    #endif
+
+
+    // reading and writing bytes: Arduino Streams have write and readBytes functions, FILE * has fwrite and fread
+    template <class streamType> size_t __snapshotWrite__ (streamType& stream, const void *buffer, size_t size) { return stream.write ((const uint8_t *) buffer, size); }
+    template <class streamType> size_t __snapshotRead__ (streamType& stream, void *buffer, size_t size) { return stream.readBytes ((char *) buffer, size); }
+    inline size_t __snapshotWrite__ (FILE *file, const void *buffer, size_t size) { return fwrite (buffer, 1, size, file); }
+    inline size_t __snapshotRead__ (FILE *file, void *buffer, size_t size) { return fread (buffer, 1, size, file); }
+
+
+    template <class streamType> class __snapshotStream__ {
+
+        public:
+
+            __snapshotStream__ (streamType& stream) : __stream__ (stream) {}
+
+            bool write (const void *buffer, size_t size) {
+                if (size == 0)
+                    return true;
+                __update__ (buffer, size);
+                return __snapshotWrite__ (__stream__, buffer, size) == size;
+            }
+
+            bool read (void *buffer, size_t size) {
+                if (size == 0)
+                    return true;
+                if (__snapshotRead__ (__stream__, buffer, size) != size)
+                    return false;
+                __update__ (buffer, size);
+                return true;
+            }
+
+            // values are written as they are in memory, Strings are length-prefixed, so they can't be longer than 65535 characters
+            template <class T> bool writeValue (const T& value) {
+                #ifndef ARDUINO_ARCH_AVR
+                    static_assert (__snapshotRaw__<T>::value, "snapshot can only write values that don't point to other memory: numbers, structures of numbers, Cstrings or Strings");
+                #endif
+                return write (&value, sizeof (T));
+            }
+
+            bool writeValue (const String& value) {
+                if (value.length () > 0xFFFF)
+                    return false;
+                uint16_t length = value.length ();
+                return write (&length, sizeof (length)) && write (value.c_str (), length);
+            }
+
+            // returns OK or one of the errors, the value must already be constructed
+            template <class T> signed char readValue (T& value) {
+                #ifndef ARDUINO_ARCH_AVR
+                    static_assert (__snapshotRaw__<T>::value, "snapshot can only read values that don't point to other memory: numbers, structures of numbers, Cstrings or Strings");
+                #endif
+                return read (&value, sizeof (T)) ? err_ok : err_bad_data;
+            }
+
+            signed char readValue (String& value) {
+                uint16_t length;
+                if (!read (&length, sizeof (length)))
+                    return err_bad_data;
+                value = "";
+                if (!value.reserve (length))
+                    return err_bad_alloc;
+                char buffer [33];
+                for (uint16_t i = 0; i < length; i += 32) {
+                    uint16_t chunk = length - i < 32 ? length - i : 32;
+                    if (!read (buffer, chunk))
+                        return err_bad_data;
+                    buffer [chunk] = 0;
+                    value += buffer;
+                }
+                if (!value)
+                    return err_bad_alloc;
+                return value.length () == length ? err_ok : err_bad_data; // Strings can't hold 0 characters
+            }
+
+            bool writeHeader (uint32_t count, uint16_t keySize, uint16_t valueSize) {
+                uint8_t header [16] = { 'L', 'S', 'T', 'L' };
+                memcpy (header + 4, &count, 4);
+                memcpy (header + 8, &keySize, 2);
+                memcpy (header + 10, &valueSize, 2);
+                header [12] = __SNAPSHOT_VERSION__;
+                return write (header, sizeof (header));
+            }
+
+            // checks if the header matches the container and returns the number of records in count
+            bool readHeader (uint32_t *count, uint16_t keySize, uint16_t valueSize) {
+                uint8_t header [16];
+                if (!read (header, sizeof (header)) || memcmp (header, "LSTL", 4) || header [12] != __SNAPSHOT_VERSION__)
+                    return false;
+                memcpy (count, header + 4, 4);
+                return !memcmp (header + 8, &keySize, 2) && !memcmp (header + 10, &valueSize, 2);
+            }
+
+            bool writeChecksum () {
+                uint32_t checksum = __checksum__;
+                return __snapshotWrite__ (__stream__, &checksum, sizeof (checksum)) == sizeof (checksum);
+            }
+
+            bool checkChecksum () {
+                uint32_t checksum;
+                return __snapshotRead__ (__stream__, &checksum, sizeof (checksum)) == sizeof (checksum) && checksum == __checksum__;
+            }
+
+        private:
+
+            streamType& __stream__;
+            uint32_t __checksum__ = 2166136261UL;   // FNV-1a offset basis
+
+            void __update__ (const void *buffer, size_t size) {
+                for (size_t i = 0; i < size; i++)
+                    __checksum__ = (__checksum__ ^ ((const uint8_t *) buffer) [i]) * 16777619UL;
+            }
+
+    };
+
+#endif
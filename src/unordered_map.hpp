@@ -0,0 +1,701 @@
+/*
+ *  unordered_map.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Hash table with open addressing (Robin Hood hashing). Pairs are stored directly in one array of slots together with their cached hashes,
+ *  so a lookup usually touches only one or two neighbouring slots and compares the keys only when the hashes match. Pairs are not ordered.
+ *  The interface is the same as the one of Map.
+ *
+ *  Pairs move within the array: an insertion may move other pairs to make room for the new one (or move all of them to a larger array when
+ *  the table grows) and an erasure moves the following pairs one slot back. References returned by [] operator and pointers returned by
+ *  get_if are valid only until the next insertion or erasure and the keys and values must not point into themselves (Strings are fine).
+ *
+ *  Keys of other types than numbers and strings are hashed byte by byte, so struct keys must not have padding bytes between their fields
+ *  (their values are not defined and equal keys could get different hashes). Such keys need their own hash function, for example:
+ *
+ *    struct point { int8_t x; int32_t y; bool operator == (const point& other) const { return x == other.x && y == other.y; } };
+ *    uint32_t __unorderedMapHash__ (const point& key) { return __unorderedMapHash__ ((uint32_t) key.x * 31 + key.y); }
+ *
+ *  unordered_map functions are not thread-safe.
+ *
+ *  February 14, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __UNORDERED_MAP_HPP__
+    #define __UNORDERED_MAP_HPP__
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define USE_MAP_EXCEPTIONS   // uncomment this line if you want unordered_map to throw exceptions (the same setting as for Map)
+
+    #ifndef UNORDERED_MAP_MAX_LOAD_FACTOR
+        #define UNORDERED_MAP_MAX_LOAD_FACTOR 0.8 // the table grows when it gets fuller than this, Robin Hood hashing still works well at 0.9 but the collisions get more expensive
+    #endif
+
+    #define __UNORDERED_MAP_MIN_CAPACITY__ 8   // must be a power of 2
+
+
+    // error flags: there are only two types of error flags that can be set: OVERFLOW and OUT_OF_RANGE - please note that all errors are negative (char) numbers
+    #define err_ok              ((signed char) 0b00000000)  //    0 - no error
+    #define err_bad_alloc       ((signed char) 0b10000001)  // -127 - out of memory
+    #define err_not_found       ((signed char) 0b10000100)  // -124 - key is not found
+    #define err_not_unique      ((signed char) 0b10001000)  // -120 - key is not unique
+
+
+    // type of memory used (the same setting as for Map)
+    #define HEAP_MEM 2
+    #define PSRAM_MEM 3
+    #ifndef MAP_MEMORY_TYPE
+        #define MAP_MEMORY_TYPE HEAP_MEM // use heap by default
+    #endif
+
+
+    // hash functions used by unordered_map and lru_cache - keys that are equal must have the same hashes, so Strings, C strings and Cstrings with the same content have the same hash
+    inline uint32_t __unorderedMapFnv1a__ (const char *p, size_t len) {
+        uint32_t h = 2166136261UL;
+        while (len --)
+            h = (h ^ (unsigned char) *p ++) * 16777619UL;
+        return h;
+    }
+
+    inline uint32_t __unorderedMapFnv1a__ (const char *s) {
+        uint32_t h = 2166136261UL;
+        while (*s)
+            h = (h ^ (unsigned char) *s ++) * 16777619UL;
+        return h;
+    }
+
+    template <class T>
+    inline uint32_t __unorderedMapHash__ (const T& key) {
+        uint32_t h;
+        if (sizeof (T) <= sizeof (uint32_t)) { // integers, characters, ... mix their bits (murmur3 finalizer) so that the lower bits, used for indexing, depend on all of them
+            h = 0;
+            memcpy (&h, &key, sizeof (T) <= sizeof (uint32_t) ? sizeof (T) : sizeof (uint32_t));
+            h ^= h >> 16; h *= 0x85ebca6bUL; h ^= h >> 13; h *= 0xc2b2ae35UL; h ^= h >> 16;
+        } else {                                // other plain types: hash all their bytes
+            h = __unorderedMapFnv1a__ ((const char *) &key, sizeof (T));
+        }
+        return h ? h : 1;                       // 0 is reserved for empty slots
+    }
+
+    // Cstring keys are compared and hashed by their characters regardless of whether Cstring.hpp is included before or after this file
+    template <size_t N> struct Cstring;
+
+    inline uint32_t __unorderedMapHash__ (const char *key) { uint32_t h = __unorderedMapFnv1a__ (key); return h ? h : 1; }
+    inline uint32_t __unorderedMapHash__ (char *key) { return __unorderedMapHash__ ((const char *) key); }
+    inline uint32_t __unorderedMapHash__ (const String& key) { return __unorderedMapHash__ (key.c_str ()); }
+    template <size_t N> inline uint32_t __unorderedMapHash__ (const Cstring<N>& key) { return __unorderedMapHash__ (key.c_str ()); }
+
+    // keys that are searched for (probes) are compared and hashed as they are, so Strings can be found by C strings and Cstrings without constructing temporary Strings,
+    // only numbers are converted to keyType first, so they find the same keys as keyType would: Map<unsigned long, float>::find (1), unordered_map<long, int>::contains (5)
+    #ifndef __MAP_PROBE__
+        #define __MAP_PROBE__
+        template <class T> struct __mapIsNumber__ { static const bool value = false; };
+        template <> struct __mapIsNumber__<bool> { static const bool value = true; };
+        template <> struct __mapIsNumber__<char> { static const bool value = true; };
+        template <> struct __mapIsNumber__<signed char> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned char> { static const bool value = true; };
+        template <> struct __mapIsNumber__<short> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned short> { static const bool value = true; };
+        template <> struct __mapIsNumber__<int> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned int> { static const bool value = true; };
+        template <> struct __mapIsNumber__<long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<long long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<unsigned long long> { static const bool value = true; };
+        template <> struct __mapIsNumber__<float> { static const bool value = true; };
+        template <> struct __mapIsNumber__<double> { static const bool value = true; };
+        template <> struct __mapIsNumber__<long double> { static const bool value = true; };
+
+        template <class keyType, class K, bool isNumber = __mapIsNumber__<K>::value> struct __mapProbe__ { static const K& key (const K& k) { return k; } };
+        template <class keyType, class K> struct __mapProbe__<keyType, K, true> { static keyType key (const K& k) { return k; } };
+    #endif
+
+    // key comparison - C strings are compared by their content, Strings are compared with C strings and Cstrings without constructing temporary Strings
+    template <class A, class B> inline bool __unorderedMapEqual__ (const A& a, const B& b) { return a == b; }
+    inline bool __unorderedMapEqual__ (const char *a, const char *b) { return !strcmp (a, b); }
+    inline bool __unorderedMapEqual__ (char *a, char *b) { return !strcmp (a, b); }
+    inline bool __unorderedMapEqual__ (const String& a, const char *b) { return !strcmp (a.c_str (), b); }
+    template <size_t N> inline bool __unorderedMapEqual__ (const String& a, const Cstring<N>& b) { return !strcmp (a.c_str (), b.c_str ()); }
+    template <size_t N> inline bool __unorderedMapEqual__ (const Cstring<N>& a, const String& b) { return !strcmp (a.c_str (), b.c_str ()); }
+    template <size_t N> inline bool __unorderedMapEqual__ (const Cstring<N>& a, const char *b) { return !strcmp (a.c_str (), b); }
+    template <size_t N, size_t M> inline bool __unorderedMapEqual__ (const Cstring<N>& a, const Cstring<M>& b) { return !strcmp (a.c_str (), b.c_str ()); }
+
+
+    template <class keyType, class valueType> class unordered_map {
+
+        private:
+
+            mutable signed char __errorFlags__ = 0;
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+            struct Pair {
+                keyType first;          // key
+                valueType second;       // value
+            };
+
+
+           /*
+            *  Constructor of unordered_map with no pairs allows the following kinds of creation of unordered_map pairs:
+            *
+            *    unordered_map<int, String> umA;
+            */
+
+            unordered_map () {}
+
+
+          #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+               /*
+                *  Constructor of unordered_map from brace enclosed initializer list allows the following kinds of creation of unordered_map pairs:
+                *
+                *     unordered_map<int, String> umB = { {1, "one"}, {2, "two"} };
+                *     unordered_map<int, String> umC ( { {1, "one"}, {2, "two"} } );
+                */
+
+                unordered_map (std::initializer_list<Pair> il) {
+                    reserve (il.size ());
+                    for (auto& i: il)
+                        if (insert (i.first, i.second) == err_bad_alloc)
+                            return;
+                }
+          #endif
+
+                // constructor accepting the array by reference, since AVR boards do not support initializer lists
+                template <int N>
+                unordered_map (const typename unordered_map<keyType, valueType>::Pair (&array) [N]) {
+                    reserve (N);
+                    for (int i = 0; i < N; ++i)
+                        if (insert (array [i].first, array [i].second) == err_bad_alloc)
+                            break;
+                }
+
+
+           /*
+            *  unordered_map destructor - free the memory occupied by pairs
+            */
+
+            ~unordered_map () { clear (); }
+
+
+           /*
+            *  Copy-constructor of unordered_map pairs allows the following kinds of creation:
+            *
+            *     unordered_map<int, String> umD = umC;
+            *
+            *  Calling program should check __errorFlags__ member variable after constructor is beeing called for possible errors
+            */
+
+            unordered_map (const unordered_map& other) {
+                __maxLoadFactor__ = other.__maxLoadFactor__;
+                reserve (other.__size__);
+                for (size_t i = 0; i < other.__capacity__; i++)
+                    if (other.__slots__ [i].hash)
+                        insert (other.__slots__ [i].pair.first, other.__slots__ [i].pair.second);
+                // copy the error flags as well
+                __errorFlags__ |= other.__errorFlags__;
+            }
+
+
+           /*
+            *  Assignment operator of unordered_map pairs allows the following kinds of assignements:
+            *
+            *     unordered_map<int, String> umE;
+            *     umE = { {3, "tree"}, {4, "four"}, {5, "five"} }; or   umE = { };
+            */
+
+            unordered_map* operator = (const unordered_map& other) {
+                if (this == &other)
+                    return this;
+                this->clear (); // clear existing pairs if needed
+
+                reserve (other.__size__);
+                for (size_t i = 0; i < other.__capacity__; i++)
+                    if (other.__slots__ [i].hash)
+                        insert (other.__slots__ [i].pair.first, other.__slots__ [i].pair.second);
+                // copy the error flags as well
+                __errorFlags__ |= other.__errorFlags__;
+
+                return this;
+            }
+
+
+           /*
+            *  Returns the number of pairs.
+            */
+
+            int size () const { return __size__; }
+
+
+           /*
+            *  Checks if there are no pairs.
+            */
+
+            bool empty () const { return __size__ == 0; }
+
+
+           /*
+            *  Returns the number of slots in the table, the ratio between the number of pairs and number of slots and sets or gets the maximum ratio before the table grows.
+            */
+
+            size_t bucket_count () const { return __capacity__; }
+
+            float load_factor () const { return __capacity__ ? (float) __size__ / __capacity__ : 0; }
+
+            float max_load_factor () const { return __maxLoadFactor__; }
+
+            void max_load_factor (float maxLoadFactor) {
+                if (maxLoadFactor < 0.25) maxLoadFactor = 0.25; // the table would mostly be empty
+                if (maxLoadFactor > 0.95) maxLoadFactor = 0.95; // there must always be an empty slot to stop the searches and Robin Hood hashing gets slow if the table is (almost) full
+                __maxLoadFactor__ = maxLoadFactor;
+                __growAt__ = (size_t) (__capacity__ * __maxLoadFactor__);
+            }
+
+
+           /*
+            *  Makes enough room for n pairs in advance so the table doesn't have to grow while they are beeing inserted. Returns OK or err_bad_alloc.
+            */
+
+            signed char reserve (size_t n) {
+                size_t capacity = __UNORDERED_MAP_MIN_CAPACITY__;
+                while ((size_t) (capacity * __maxLoadFactor__) < n)
+                    capacity <<= 1;
+                if (capacity <= __capacity__)
+                    return err_ok;
+                return __rehash__ (capacity);
+            }
+
+
+           /*
+            *  Clears all the pairs and frees the table.
+            */
+
+            void clear () {
+                for (size_t i = 0; i < __capacity__; i++)
+                    if (__slots__ [i].hash)
+                        __slots__ [i].pair.~Pair ();
+                free (__slots__);
+                __slots__ = NULL;
+                __capacity__ = 0;
+                __growAt__ = 0;
+                __size__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  [] operator enables unordered_map elements to be conveniently addressed by their keys like:
+            *
+            *    value = um [key];
+            *       or
+            *    um [key] = value;
+            *
+            *  Operator searches for the slot containing the key. It it can't be found it inserts a new pair into the unordered_map.
+            *  Error handling can be somewhat tricky. It may be a good idea to use USE_MAP_EXCEPTIONS if using [] operator.
+            *  The reference is valid only until the next insertion or erasure, which may move the pair.
+            */
+
+            // um [key] = value version of [] operator, key can be of any type comparable to keyType (like const char * for String keys), keyType is constructed only if a new pair is inserted
+            template <class K>
+            valueType &operator [] (const K& key) {
+                static valueType dummyValue1 = {};
+                static valueType dummyValue2 = {};
+
+                if (is_same<K, String>::value)            // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &key) {              // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;  // report error if it is not
+                        dummyValue1 = dummyValue2;
+                        return dummyValue1;               // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
+                    }
+
+                __slot__ *s = __find__ (key);
+                if (s)
+                    return s->pair.second;                // found, return the reference ot the value
+                // else                                   // not found, insert a new pair
+                keyType newKey = key;
+                if (is_same<keyType, String>::value && !*(String *) &newKey) { // check if construction is valid
+                    // log_e ("BAD_ALLOC");
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                } else if (__insert__ (newKey, dummyValue2, &s) == err_ok)
+                    return s->pair.second;
+                // else there was some kind of error
+                dummyValue1 = dummyValue2;
+                return dummyValue1;                       // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
+            }
+
+            // value = um [key] version of [] operator (similar as above, but without inserting a key)
+            template <class K>
+            const valueType &operator [] (const K& key) const {
+                static valueType dummyValue1 = {};
+                static valueType dummyValue2 = {};
+
+                __slot__ *s = __find__ (key);
+                if (s)
+                    return s->pair.second;                // found, return the reference ot the value
+                // else                                   // not found
+                dummyValue1 = dummyValue2;
+                return dummyValue1;                       // operator must return a reference, so return the reference to dummy value (make a copy of the default value first)
+            }
+
+
+           /*
+            *  Checks if there is a pair with the key. Key can be of any type comparable to keyType.
+            */
+
+            template <class K>
+            bool contains (const K& key) const { return __find__ (key) != NULL; }
+
+
+           /*
+            *  Returns the pointer to the value of the pair with the key or NULL if there is no such pair. Key can be of any type comparable to keyType.
+            *  The pointer is valid only until the next insertion or erasure, which may move the pair.
+            */
+
+            template <class K>
+            valueType *get_if (const K& key) {
+                __slot__ *s = __find__ (key);
+                return s ? &(s->pair.second) : NULL;
+            }
+
+            template <class K>
+            const valueType *get_if (const K& key) const {
+                __slot__ *s = __find__ (key);
+                return s ? &(s->pair.second) : NULL;
+            }
+
+
+           /*
+            *  Erases the unordered_map pair identified by key
+            *
+            *  Returns OK if succeeds and error err_not_found or err_bad_alloc if String key parameter could not be constructed.
+            */
+
+            template <class K>
+            signed char erase (const K& key) {
+
+                if (is_same<K, String>::value)         // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &key) {                 // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;        // report error if it is not
+                        return err_bad_alloc;                   // report error if it is not
+                    }
+
+                __slot__ *s = __find__ (key);
+                if (s == NULL) {
+                    // log_e ("NOT_FOUND");
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_not_found;
+                    #endif
+                    __errorFlags__ |= err_not_found;
+                    return err_not_found;
+                }
+
+                s->pair.~Pair ();
+                __removeSlot__ (s);
+                __size__ --;
+                return err_ok;
+            }
+
+
+           /*
+            *  Inserts a new unordered_map pair, returns OK or one of the errors.
+            */
+
+            signed char insert (const Pair& pair) { return insert (pair.first, pair.second); }
+
+            signed char insert (const keyType& key, const valueType& value) {
+
+                if (is_same<keyType, String>::value)   // if key is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &key) {                             // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;        // report error if it is not
+                        return err_bad_alloc;                   // report error if it is not
+                    }
+
+                if (is_same<valueType, String>::value) // if value is of type String ... (if anyone knows hot to do this in compile-time a feedback is welcome)
+                    if (!*(String *) &value) {               // ... check if parameter construction is valid
+                        // log_e ("BAD_ALLOC");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_bad_alloc;
+                        #endif
+                        __errorFlags__ |= err_bad_alloc;        // report error if it is not
+                        return err_bad_alloc;                   // report error if it is not
+                    }
+
+                __slot__ *s;
+                return __insert__ (key, value, &s);
+            }
+
+
+           /*
+            *   Iterator, pairs are visited in the order of slots, not in the order of keys
+            *
+            *   Example:
+            *    for (auto& pair: um)
+            *        Serial.println (String (pair.first) + "-" + String (pair.second));
+            */
+
+        private:
+
+            struct __slot__ {
+                uint32_t hash;          // cached hash of the key, 0 means that the slot is empty
+                Pair pair;
+            };
+
+        public:
+
+            class iterator {
+
+              public:
+
+                iterator (__slot__ *slot, __slot__ *end) {
+                    __current__ = slot;
+                    __end__ = end;
+                    while (__current__ < __end__ && __current__->hash == 0) // skip empty slots
+                        __current__ ++;
+                }
+
+                // * operator
+                Pair& operator *() { return __current__->pair; }
+
+                // -> operator
+                Pair * operator -> () { return &__current__->pair; }
+
+                // ++ (prefix) increment moves to the next occupied slot
+                iterator& operator ++ () {
+                    do
+                        __current__ ++;
+                    while (__current__ < __end__ && __current__->hash == 0);
+                    return *this;
+                }
+
+                friend bool operator != (const iterator& a, const iterator& b) { return a.__current__ != b.__current__; }
+                friend bool operator == (const iterator& a, const iterator& b) { return a.__current__ == b.__current__; }
+
+            private:
+
+                unordered_map::__slot__ *__current__;
+                unordered_map::__slot__ *__end__;
+            };
+
+            iterator begin () { return iterator (__slots__, __slots__ + __capacity__); }
+            iterator end ()   { return iterator (__slots__ + __capacity__, __slots__ + __capacity__); }
+
+
+           /*
+            *  Returns an iterator to the pair with the key, if key is found, end () if it is not. Example:
+            *
+            *    auto it = umB.find (1);
+            *    if (it != umB.end ())
+            *        Serial.println (it->second);
+            *    else
+            *        Serial.println ("not found");
+            */
+
+            template <class K>
+            iterator find (const K& key) {
+                __slot__ *s = __find__ (key);
+                return s ? iterator (s, __slots__ + __capacity__) : end ();
+            }
+
+            #ifdef __OSTREAM_HPP__
+                // print unordered_map to ostream
+                friend ostream& operator << (ostream& os, unordered_map& m) {
+                    bool first = true;
+                    for (const auto& e : m) {
+                        if (!first)
+                            os << ",";
+                        first = false;
+                        os << "{" << e.first << "," << e.second << "}";
+                    }
+                    return os;
+                }
+            #endif
+
+        private:
+
+            __slot__ *__slots__ = NULL;
+            size_t __capacity__ = 0;                                    // always 0 or a power of 2
+            size_t __size__ = 0;
+            size_t __growAt__ = 0;                                      // = __capacity__ * __maxLoadFactor__
+            float __maxLoadFactor__ = UNORDERED_MAP_MAX_LOAD_FACTOR;
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            // the distance of the slot i from the home slot of the hash
+            size_t __distance__ (size_t i, uint32_t hash) const { return (i - (hash & (__capacity__ - 1))) & (__capacity__ - 1); }
+
+            // returns the slot with the key or NULL if it is not found, numbers are converted to keyType first, so they hash the same as the keys
+            template <class K>
+            __slot__ *__find__ (const K& probe) const {
+                const auto& key = __mapProbe__<keyType, K>::key (probe);
+                return __find__ (key, __unorderedMapHash__ (key));
+            }
+
+            template <class K>
+            __slot__ *__find__ (const K& key, uint32_t hash) const {
+                if (__size__ == 0)
+                    return NULL;
+                size_t mask = __capacity__ - 1;
+                size_t i = hash & mask;
+                for (size_t d = 0; ; d++) {
+                    __slot__ *s = &__slots__ [i];
+                    if (s->hash == 0 || __distance__ (i, s->hash) < d)  // the key would have been placed here if it existed
+                        return NULL;
+                    if (s->hash == hash && __unorderedMapEqual__ (s->pair.first, key))
+                        return s;
+                    i = (i + 1) & mask;
+                }
+            }
+
+            // backward shift deletion: moves the following pairs that are not in their home slots one slot back, so no tombstones are needed
+            void __removeSlot__ (__slot__ *s) {
+                size_t mask = __capacity__ - 1;
+                size_t i = s - __slots__;
+                while (true) {
+                    size_t j = (i + 1) & mask;
+                    if (__slots__ [j].hash == 0 || __distance__ (j, __slots__ [j].hash) == 0)
+                        break;
+                    memcpy ((void *) &__slots__ [i], (void *) &__slots__ [j], sizeof (__slot__));
+                    i = j;
+                }
+                __slots__ [i].hash = 0;
+            }
+
+            // moves the (raw bytes of) slot into the table, starting at slot i at distance d from its home slot, Robin Hood style: a slot that is further
+            // from its home takes the place of the slot that is closer to its home, which then continues looking for an empty slot
+            static void __moveIn__ (__slot__ *slots, size_t mask, char *slot, size_t i, size_t d) {
+                alignas (__slot__) char tmp [sizeof (__slot__)];
+                while (true) {
+                    __slot__ *s = &slots [i];
+                    if (s->hash == 0) {
+                        memcpy ((void *) s, slot, sizeof (__slot__));
+                        return;
+                    }
+                    size_t sd = (i - (s->hash & mask)) & mask;
+                    if (sd < d) {
+                        memcpy (tmp, (void *) s, sizeof (__slot__));
+                        memcpy ((void *) s, slot, sizeof (__slot__));
+                        memcpy (slot, tmp, sizeof (__slot__));
+                        d = sd;
+                    }
+                    i = (i + 1) & mask;
+                    d ++;
+                }
+            }
+
+            // moves all the pairs to a new table with newCapacity slots, pairs are relocated by copying their bytes, like Strings are swapped in Map
+            signed char __rehash__ (size_t newCapacity) {
+                #if MAP_MEMORY_TYPE == PSRAM_MEM
+                    __slot__ *newSlots = (__slot__ *) ps_malloc (newCapacity * sizeof (__slot__));
+                #else
+                    __slot__ *newSlots = (__slot__ *) malloc (newCapacity * sizeof (__slot__));
+                #endif
+                if (newSlots == NULL) {
+                    // log_e ("BAD_ALLOC");
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+                memset ((void *) newSlots, 0, newCapacity * sizeof (__slot__));
+
+                for (size_t i = 0; i < __capacity__; i++)
+                    if (__slots__ [i].hash)
+                        __moveIn__ (newSlots, newCapacity - 1, (char *) &__slots__ [i], __slots__ [i].hash & (newCapacity - 1), 0);
+
+                free (__slots__);
+                __slots__ = newSlots;
+                __capacity__ = newCapacity;
+                __growAt__ = (size_t) (__capacity__ * __maxLoadFactor__);
+                return err_ok;
+            }
+
+            signed char __insert__ (const keyType& key, const valueType& value, __slot__ **pInserted) { // returns OK or error
+                if (__size__ + 1 > __growAt__) {
+                    signed char e = __rehash__ (__capacity__ ? __capacity__ << 1 : __UNORDERED_MAP_MIN_CAPACITY__);
+                    if (e)
+                        return e;
+                }
+
+                // find the slot where the new pair belongs, checking that the key doesn't exist yet on the way
+                uint32_t hash = __unorderedMapHash__ (key);
+                size_t mask = __capacity__ - 1;
+                size_t i = hash & mask;
+                size_t d = 0;
+                while (__slots__ [i].hash != 0 && __distance__ (i, __slots__ [i].hash) >= d) {
+                    if (__slots__ [i].hash == hash && __unorderedMapEqual__ (__slots__ [i].pair.first, key)) { // the pair with the same key already exists
+                        // log_e ("NOT_UNIQUE");
+                        #ifdef USE_MAP_EXCEPTIONS
+                            throw err_not_unique;
+                        #endif
+                        __errorFlags__ |= err_not_unique;
+                        return err_not_unique;
+                    }
+                    i = (i + 1) & mask;
+                    d ++;
+                }
+
+                // if the slot is occupied by a pair that is closer to its home, move it (and the following ones) further
+                __slot__ *s = &__slots__ [i];
+                if (s->hash) {
+                    alignas (__slot__) char displaced [sizeof (__slot__)];
+                    memcpy (displaced, (void *) s, sizeof (__slot__));
+                    s->hash = 0;
+                    __moveIn__ (__slots__, mask, displaced, (i + 1) & mask, __distance__ (i, ((__slot__ *) displaced)->hash) + 1);
+                }
+
+                // construct the new pair in the slot
+                memset ((void *) s, 0, sizeof (__slot__));
+                #ifndef ARDUINO_ARCH_AVR // Assuming Arduino Mega or Uno
+                    new (&s->pair) Pair {key, value};
+                #else
+                    s->pair.first = key;
+                    s->pair.second = value;
+                #endif
+
+                // in case of Strings - it is possible that key and value didn't get constructed
+                if ((is_same<keyType, String>::value && !*(String *) &s->pair.first) || (is_same<valueType, String>::value && !*(String *) &s->pair.second)) {
+                    // undo the insertion
+                    s->pair.~Pair ();
+                    __removeSlot__ (s);
+                    // log_e ("BAD_ALLOC");
+                    #ifdef USE_MAP_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return err_bad_alloc;
+                }
+
+                s->hash = hash;
+                __size__ ++;
+                *pInserted = s;
+                return err_ok;
+            }
+    };
+
+#endif
@@ -0,0 +1,499 @@
+/*
+ *  unrolled_list.hpp for Arduino
+ *
+ *  This file is part of Lightweight C++ Standard Template Library (STL) for Arduino: https://github.com/BojanJurca/Lightweight-Standard-Template-Library-STL-for-Arduino
+ *
+ *  Unrolled list stores up to elementsPerNode elements in each node. For small elements, like int, float or char*, a single - linked list
+ *  spends more memory on the next pointer and malloc header than on the element itself, and each element visited during traversal is
+ *  a new cache (or PSRAM cache) miss. Packing more elements into a node spreads this overhead among them and keeps neighbouring elements
+ *  in the same memory block:
+ *
+ *    | next, prev, count | e0 e1 e2 ... e7 |  ->  | next, prev, count | e8 e9 ... |  ->  NULL
+ *
+ *  Elements within a node are kept at the beginning of the node. Inserting at the front or erasing in the middle moves the remaining
+ *  elements of that node by copying their memory (the same way Strings are moved around in other containers of this library), so
+ *  elements must not hold pointers to themselves. A node that becomes empty is freed, and a node that could fit into its neighbour
+ *  after erase is merged with it, so nodes stay at least about half full.
+ *
+ *  February 6, 2026, Bojan Jurca
+ *
+ */
+
+
+#ifndef __UNROLLED_LIST_HPP__
+    #define __UNROLLED_LIST_HPP__
+
+
+    // ----- TUNNING PARAMETERS -----
+
+    // #define THROW_LIST_EXCEPTIONS  // uncomment this line if you want list to throw exceptions
+
+
+    // error flags: there is only one type of error flags that can be set: err_bad_alloc - please note that all errors are negative (char) numbers
+    #define err_ok           ((signed char) 0b00000000) //    0 - no error
+    #define err_bad_alloc    ((signed char) 0b10000001) // -127 - out of memory
+    #define err_out_of_range ((signed char) 0b10000010) // -126 - invalid addressing of list element
+
+
+    // type of memory used (the same setting as for single - linked lists)
+    #define HEAP_MEM 2
+    #define PSRAM_MEM 3
+    #ifndef LIST_MEMORY_TYPE
+        #define LIST_MEMORY_TYPE HEAP_MEM // use heap by default
+    #endif
+
+
+    template <class listType, int elementsPerNode = 8> class unrolled_list {
+
+        static_assert (elementsPerNode >= 2 && elementsPerNode <= 255, "elementsPerNode should be between 2 and 255");
+
+        private:
+
+            signed char __errorFlags__ = 0;
+
+            // node's memory is allocated with malloc and elements are constructed one by one when they are added, so node_t itself is never constructed
+            struct node_t {
+                node_t *next;
+                node_t *prev;
+                unsigned char count;
+                listType element [elementsPerNode];
+            };
+
+
+        public:
+
+            signed char errorFlags () const { return __errorFlags__ & 0b01111111; }
+            void clearErrorFlags () { __errorFlags__ = 0; }
+
+
+           /*
+            *  Constructor of unrolled_list with no elements allows the following kinds of creation of lists:
+            *
+            *    unrolled_list<int> A;
+            *    unrolled_list<int, 16> B; // 16 elements per node
+            */
+
+            unrolled_list () {}
+
+
+            #ifndef ARDUINO_ARCH_AVR
+                   /*
+                    *  Constructor of unrolled_list from brace enclosed initializer list allows the following kinds of creation of list:
+                    *
+                    *     unrolled_list<int> D = { 200, 300, 400 };
+                    *     unrolled_list<int> E ( { 500, 600 } );
+                    */
+
+                    unrolled_list (const std::initializer_list<listType>& il) {
+                        for (auto element: il)
+                            if (push_back (element)) // error
+                                break;
+                    }
+            #endif
+                // constructor accepting the array by reference, since AVR boards do not support initializer lists
+                template <int N>
+                unrolled_list (const listType (&array) [N]) {
+                    for (int i = 0; i < N; ++i)
+                        if (push_back (array [i])) // error
+                            break;
+                }
+
+
+           /*
+            * List destructor - free the memory occupied by list elements
+            */
+
+            ~unrolled_list () {
+                clear ();
+            }
+
+
+           /*
+            * Returns the number of elements in the list.
+            */
+
+            int size () { return __size__; }
+
+
+           /*
+            * Checks if list is empty.
+            */
+
+            bool empty () { return __size__ == 0; }
+
+
+           /*
+            * Clears all the elements from the list.
+            */
+
+            void clear () {
+                node_t *p = __front__;
+                while (p) {
+                    node_t *q = p->next;
+                    for (int i = 0; i < p->count; i++)
+                        __destruct__ (&p->element [i]);
+                    free (p);
+                    p = q;
+                }
+                __front__ = __back__ = NULL;
+                __size__ = 0;
+                clearErrorFlags ();
+            }
+
+
+           /*
+            *  Copy-constructor of unrolled_list allows the following kinds of creation of list:
+            *
+            *     unrolled_list<int> F = E;
+            *
+            *  Calling program should check errorFlags () after constructor is beeing called for possible errors
+            */
+
+            unrolled_list (unrolled_list& other) {
+                for (auto element: other)
+                    if (this->push_back (element)) // error
+                        break;
+            }
+
+
+           /*
+            *  Assignment operator of unrolled_list allows the following kinds of assignements of list:
+            *
+            *     unrolled_list<int> F;
+            *     F = { 1, 2, 3 }; or F = {};
+            */
+
+            unrolled_list* operator = (unrolled_list& other) {
+                if (this == &other)
+                    return this;
+                this->clear (); // clear existing elements if needed
+
+                for (auto element: other)
+                    if (this->push_back (element)) // error
+                        break;
+                return this;
+            }
+
+
+           /*
+            *  Adds element to the end of a list, like:
+            *
+            *    E.push_back (700);
+            *
+            *  A new node is only allocated when the last one is full.
+            *
+            *  Returns OK or one of the error flags in case of error:
+            *    - could not allocate enough memory for requested storage
+            */
+
+            signed char push_back (const listType& element) {
+                if (__back__ == NULL || __back__->count == elementsPerNode)
+                    if (!__newNode__ (__back__, NULL))
+                        return err_bad_alloc;
+
+                if (!__construct__ (&__back__->element [__back__->count], element)) {
+                    if (__back__->count == 0)
+                        __freeNode__ (__back__);
+                    return __badAlloc__ ();
+                }
+                __back__->count ++;
+                __size__ ++;
+                return err_ok;
+            }
+
+
+           /*
+            *  Adds element to the beginning of a list, like:
+            *
+            *    E.push_front (600);
+            *
+            *  Elements of the first node are moved one place up to make room if needed, a new node is only allocated when the first one is full.
+            *
+            *  Returns OK or one of the error flags in case of error:
+            *    - could not allocate enough memory for requested storage
+            */
+
+            signed char push_front (const listType& element) {
+                if (__front__ == NULL || __front__->count == elementsPerNode)
+                    if (!__newNode__ (NULL, __front__))
+                        return err_bad_alloc;
+
+                memmove (&__front__->element [1], &__front__->element [0], __front__->count * sizeof (listType));
+                if (!__construct__ (&__front__->element [0], element)) {
+                    memmove (&__front__->element [0], &__front__->element [1], __front__->count * sizeof (listType));
+                    if (__front__->count == 0)
+                        __freeNode__ (__front__);
+                    return __badAlloc__ ();
+                }
+                __front__->count ++;
+                __size__ ++;
+                return err_ok;
+            }
+
+
+           /*
+            * Removes the first or the last element from the list.
+            */
+
+            signed char pop_front () {
+                if (__front__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __erase__ (__front__, 0);
+                return err_ok;
+            }
+
+            signed char pop_back () {
+                if (__back__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return err_out_of_range;
+                }
+                __erase__ (__back__, __back__->count - 1);
+                return err_ok;
+            }
+
+
+           /*
+            * Returns the reference to the first element of the list.
+            */
+
+            listType& front () {
+                if (__front__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    static listType ev = {};
+                    return ev;
+                }
+                return __front__->element [0];
+            }
+
+
+           /*
+            * Returns the reference to the last element of the list.
+            */
+
+            listType& back () {
+                if (__back__ == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    static listType ev = {};
+                    return ev;
+                }
+                return __back__->element [__back__->count - 1];
+            }
+
+
+           /*
+            *  Iterator is needed in order for STL C++ for each loop to work.
+            *
+            *  Example:
+            *
+            *    for (auto element: A)
+            *      Serial.println (element);
+            */
+
+            class iterator {
+
+                friend unrolled_list;
+
+                public:
+
+                    // constructor
+                    iterator (node_t *p, int i) { __p__ = p; __i__ = i; }
+
+                    // * operator
+                    listType& operator *() const { return __p__->element [__i__]; }
+
+                    // ++ (prefix) increment, move to the next node only when all the elements of the current one have been visited
+                    iterator& operator ++ () {
+                        if (++ __i__ == __p__->count) {
+                            __p__ = __p__->next;
+                            __i__ = 0;
+                        }
+                        return *this;
+                    }
+
+                    // C++ will stop iterating when != operator returns false
+                    friend bool operator != (const iterator& a, const iterator& b) { return a.__p__ != b.__p__ || a.__i__ != b.__i__; }
+                    friend bool operator == (const iterator& a, const iterator& b) { return a.__p__ == b.__p__ && a.__i__ == b.__i__; }
+
+                    // this will tell if iterator is valid (if there are not elements the iterator can not be valid)
+                    operator bool () const { return __p__ != NULL; }
+
+                private:
+
+                    node_t *__p__ = NULL;
+                    int __i__ = 0;
+
+            };
+
+            iterator begin () { return iterator (__front__, 0); }           // first element
+            iterator end () { return iterator (NULL, 0); }                  // past the last element
+
+
+           /*
+            *  Deletes the element pointed to by iterator. Only the elements of the same node need to be moved, so this takes O(elementsPerNode) time.
+            *
+            *  Returns the iterator pointing to the element following the deleted one.
+            */
+
+            iterator erase (iterator pos) {
+                if (!pos.__p__) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_out_of_range;
+                    #endif
+                    __errorFlags__ |= err_out_of_range;
+                    return end ();
+                }
+                return __erase__ (pos.__p__, pos.__i__);
+            }
+
+
+           /*
+            * Deletes all the occurrences of an element
+            */
+
+        private:
+
+            template<typename T1, typename T2> inline __attribute__((always_inline)) bool __equals__ (const T1& a, const T2& b);
+            // C strings are compared by their characters, these overloads take the place of list's specializations that are not possible with elementsPerNode
+            inline __attribute__((always_inline)) bool __equals__ (const char* const& a, const char* const& b) { return strcmp (a, b) == 0; }
+            inline __attribute__((always_inline)) bool __equals__ (char* const& a, char* const& b) { return strcmp (a, b) == 0; }
+
+        public:
+
+            void remove (const listType& element) {
+                iterator it = begin ();
+                while (it.__p__)
+                    if (__equals__ (*it, element))
+                        it = __erase__ (it.__p__, it.__i__);
+                    else
+                        ++ it;
+            }
+
+
+            #ifdef __OSTREAM_HPP__
+                // print list to ostream
+                friend ostream& operator << (ostream& os, unrolled_list& l) {
+                    os << "(front)🡒";
+                    for (auto e : l)
+                        os << e << "🡒";
+                    os << "(null)";
+                    return os;
+                }
+            #endif
+
+
+      private:
+
+            node_t *__front__ = NULL;         // points to the first list node, initially the list has no nodes
+            node_t *__back__ = NULL;          // points to the last list node, initially the list has no nodes
+            int __size__ = 0;                 // initially there are not elements in the list
+
+            // allocates an empty node and links it between prev and next, returns NULL in case of error
+            node_t *__newNode__ (node_t *prev, node_t *next) {
+                // allocate new memory for node
+                #if LIST_MEMORY_TYPE == PSRAM_MEM
+                    node_t *newNode = (node_t *) ps_malloc (sizeof (node_t));
+                #else // use heap
+                    node_t *newNode = (node_t *) malloc (sizeof (node_t));
+                #endif
+                if (newNode == NULL) {
+                    #ifdef THROW_LIST_EXCEPTIONS
+                        throw err_bad_alloc;
+                    #endif
+                    __errorFlags__ |= err_bad_alloc;
+                    return NULL;
+                }
+
+                memset (newNode, 0, sizeof (node_t));
+                newNode->prev = prev;
+                newNode->next = next;
+                if (prev) prev->next = newNode; else __front__ = newNode;
+                if (next) next->prev = newNode; else __back__ = newNode;
+                return newNode;
+            }
+
+            // unlinks and frees (already empty) node
+            void __freeNode__ (node_t *p) {
+                if (p->prev) p->prev->next = p->next; else __front__ = p->next;
+                if (p->next) p->next->prev = p->prev; else __back__ = p->prev;
+                free (p);
+            }
+
+            // deletes i-th element of node p and returns the iterator pointing to the following element
+            iterator __erase__ (node_t *p, int i) {
+                __destruct__ (&p->element [i]);
+                p->count --;
+                memmove (&p->element [i], &p->element [i + 1], (p->count - i) * sizeof (listType));
+                __size__ --;
+
+                if (p->count == 0) { // free empty node
+                    node_t *next = p->next;
+                    __freeNode__ (p);
+                    return iterator (next, 0);
+                }
+
+                // merge the next node into this one if they both fit, the following elements keep their positions in p
+                node_t *next = p->next;
+                if (next && p->count + next->count <= elementsPerNode) {
+                    memcpy (&p->element [p->count], &next->element [0], next->count * sizeof (listType));
+                    p->count += next->count;
+                    __freeNode__ (next);
+                }
+
+                if (i < p->count)
+                    return iterator (p, i);
+                return iterator (p->next, 0);
+            }
+
+            // Mega and Uno do no thave is_same implemented, so we have tio imelement it ourselves: https://stackoverflow.com/questions/15200516/compare-typedef-is-same-type
+            template<typename T, typename U> struct is_same { static const bool value = false; };
+            template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+            // constructs element at the given memory location, returns false if String element could not be constructed
+            bool __construct__ (listType *e, const listType& element) {
+                #ifndef ARDUINO_ARCH_AVR
+                    new (e) listType (element);
+                #else
+                    memset ((void *) e, 0, sizeof (listType)); // the memory may still hold the bytes of a moved element
+                    *e = element; // objects not supported for AVR boards
+                #endif
+
+                if (is_same<listType, String>::value)          // if element is of type String ...
+                    if (!*(String *) e) {                       // ... check if construction is valid
+                        __destruct__ (e);
+                        return false;
+                    }
+                return true;
+            }
+
+            signed char __badAlloc__ () {
+                #ifdef THROW_LIST_EXCEPTIONS
+                    throw err_bad_alloc;
+                #endif
+                __errorFlags__ |= err_bad_alloc;
+                return err_bad_alloc;
+            }
+
+            // destructs element at the given memory location without freeing it
+            void __destruct__ (listType *e) {
+                e->~listType ();
+            }
+
+    };
+
+    template<typename listType, int elementsPerNode> template<typename T1, typename T2> __attribute__((always_inline)) bool unrolled_list<listType, elementsPerNode>::__equals__ (const T1& a, const T2& b) { return a == b; }
+
+#endif
@@ -54,6 +54,9 @@
     #endif
 
 
+    #include "snapshot.hpp" // binary save and load
+
+
     template <class vectorType> class vector {
 
         private: 
@@ -632,6 +635,58 @@
                 }
             }
 
+           /*
+            *  Saves the elements into a binary snapshot, stream can be File, any other Arduino Stream or FILE *. The elements are written as they are in memory,
+            *  so this is meant for numbers, structures and Cstrings, not for objects that point to some other memory (vector<String> is handled separately).
+            *  Returns OK or err_bad_data if the stream couldn't be written. Example:
+            *
+            *    File f = LittleFS.open ("/calibration.bin", "w");
+            *    calibration.save (f);
+            *    f.close ();
+            */
+
+            template <class streamType>
+            signed char save (streamType& stream) {
+                #ifndef ARDUINO_ARCH_AVR
+                    static_assert (__snapshotRaw__<vectorType>::value, "snapshot can only write elements that don't point to other memory: numbers, structures of numbers or Cstrings");
+                #endif
+                __snapshotStream__<streamType> s (stream);
+                // the elements are in circular queue, so they are written in (at most) two blocks
+                size_t firstBlock = __capacity__ - __front__ < __size__ ? __capacity__ - __front__ : __size__;
+                if (s.writeHeader (__size__, sizeof (vectorType), 0) && s.write (__elements__ + __front__, firstBlock * sizeof (vectorType)) && s.write (__elements__, (__size__ - firstBlock) * sizeof (vectorType)) && s.writeChecksum ())
+                    return err_ok;
+                #ifdef THROW_VECTOR_QUEUE_EXCEPTIONS
+                    throw err_bad_data;
+                #endif
+                __errorFlags__ |= err_bad_data;
+                return err_bad_data;
+            }
+
+
+           /*
+            *  Replaces the elements with the elements from a binary snapshot made by save. All the elements are read at once, directly into vector's storage.
+            *  Returns OK, err_bad_alloc or err_bad_data if the snapshot is incomplete, corrupted (checksum) or made by a different kind of vector. Example:
+            *
+            *    File f = LittleFS.open ("/calibration.bin", "r");
+            *    if (calibration.load (f) != err_ok)
+            *        calibrate ();
+            *    f.close ();
+            */
+
+            template <class streamType>
+            signed char load (streamType& stream) {
+                clear ();
+                __snapshotStream__<streamType> s (stream);
+                signed char e = __load__ (s);
+                if (e != err_ok) {
+                    #ifdef THROW_VECTOR_QUEUE_EXCEPTIONS
+                        throw e;
+                    #endif
+                    __errorFlags__ |= e;
+                }
+                return e;
+            }
+
             #ifdef __OSTREAM_HPP__
                 // print vector to ostream
                 friend ostream& operator << (ostream& os, vector& v) {
@@ -743,6 +798,33 @@
                 return err_ok;
             }
 
+
+            // reads the snapshot into an empty vector, returns OK or one of the errors
+            template <class streamType>
+            signed char __load__ (__snapshotStream__<streamType>& s) {
+                #ifndef ARDUINO_ARCH_AVR
+                    static_assert (__snapshotRaw__<vectorType>::value, "snapshot can only read elements that don't point to other memory: numbers, structures of numbers or Cstrings");
+                #endif
+                uint32_t n;
+                if (!s.readHeader (&n, sizeof (vectorType), 0) || n > (size_t) -1 / sizeof (vectorType))
+                    return err_bad_data;
+                if (n > 0) {
+                    signed char e = __changeCapacity__ (n);
+                    if (e != err_ok)
+                        return e;
+                    if (!s.read (__elements__, n * sizeof (vectorType))) {
+                        __changeCapacity__ (0);
+                        return err_bad_data;
+                    }
+                    __size__ = n;
+                }
+                if (!s.checkChecksum ()) {
+                    __changeCapacity__ (0);
+                    return err_bad_data;
+                }
+                return err_ok;
+            }
+
     };
     
 
@@ -1370,6 +1452,46 @@
                 }
             }
 
+           /*
+            *  Saves the Strings into a binary snapshot, stream can be File, any other Arduino Stream or FILE *. Each String is written as its length followed by
+            *  its characters. Returns OK or err_bad_data if the stream couldn't be written (or a String is longer than 65535 characters).
+            */
+
+            template <class streamType>
+            signed char save (streamType& stream) {
+                __snapshotStream__<streamType> s (stream);
+                bool ok = s.writeHeader (__size__, sizeof (String), 0);
+                for (size_t i = 0; ok && i < __size__; i++)
+                    ok = s.writeValue (__elements__ [(__front__ + i) % __capacity__]);
+                if (ok && s.writeChecksum ())
+                    return err_ok;
+                #ifdef THROW_VECTOR_QUEUE_EXCEPTIONS
+                    throw err_bad_data;
+                #endif
+                __errorFlags__ |= err_bad_data;
+                return err_bad_data;
+            }
+
+
+           /*
+            *  Replaces the Strings with the Strings from a binary snapshot made by save. Returns OK, err_bad_alloc or err_bad_data if the snapshot is incomplete,
+            *  corrupted (checksum) or not made by vector<String>.
+            */
+
+            template <class streamType>
+            signed char load (streamType& stream) {
+                clear ();
+                __snapshotStream__<streamType> s (stream);
+                signed char e = __load__ (s);
+                if (e != err_ok) {
+                    #ifdef THROW_VECTOR_QUEUE_EXCEPTIONS
+                        throw e;
+                    #endif
+                    __errorFlags__ |= e;
+                }
+                return e;
+            }
+
             #ifdef __OSTREAM_HPP__
                 // print vector to ostream
                 friend ostream& operator << (ostream& os, vector& v) {
@@ -1476,6 +1598,33 @@
             }
 
 
+            // reads the snapshot into an empty vector, returns OK or one of the errors
+            template <class streamType>
+            signed char __load__ (__snapshotStream__<streamType>& s) {
+                uint32_t n;
+                if (!s.readHeader (&n, sizeof (String), 0) || n > (size_t) -1 / sizeof (String))
+                    return err_bad_data;
+                if (n > 0) {
+                    signed char e = __changeCapacity__ (n);
+                    if (e != err_ok)
+                        return e;
+                    for (size_t i = 0; i < n; i++) {
+                        e = s.readValue (__elements__ [i]);
+                        if (e != err_ok) {
+                            __changeCapacity__ (0);
+                            return e;
+                        }
+                        __size__ ++;
+                    }
+                }
+                if (!s.checkChecksum ()) {
+                    __changeCapacity__ (0);
+                    return err_bad_data;
+                }
+                return err_ok;
+            }
+
+
             // swap strings by swapping their stack memory so constructors doesn't get called and nothing can go wrong like running out of memory meanwhile 
             void __swapStrings__ (String *a, String *b) {
                 char tmp [sizeof (String)];